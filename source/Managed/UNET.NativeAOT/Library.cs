@@ -0,0 +1,7 @@
+﻿namespace UNET.NativeAOT;
+
+/// <summary>
+/// Compilation root of NativeAOT library, all code lives in referenced loader and plugins
+/// </summary>
+internal static class Library
+{ }
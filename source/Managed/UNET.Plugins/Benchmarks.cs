@@ -0,0 +1,75 @@
+﻿using System.Diagnostics;
+
+using UNET.Interop;
+
+namespace UNET.Plugins;
+
+/// <summary>
+/// Benchmarks measured on managed side, values must match <c>UNET::EManagedBenchmark</c>
+/// </summary>
+internal enum ManagedBenchmark
+{
+    LogRoundTrip,
+    ManagedToNativeCall,
+    PropertyReadWrite,
+}
+
+internal static unsafe class Benchmarks
+{
+    private const string LogMessage = "UNET benchmark";
+
+    // enough for all instances created by native side of PropertyReadWrite
+    private const int MaxPropertyObjects = 64;
+
+    public static double Run(ManagedBenchmark benchmark, int iterations, nint managedClass, int numProperties)
+    {
+        var stopwatch = Stopwatch.StartNew();
+
+        switch (benchmark)
+        {
+            case ManagedBenchmark.LogRoundTrip:
+                for (var i = 0; i < iterations; i++)
+                {
+                    Debug.Log(ELogVerbosity.VeryVerbose, LogMessage);
+                }
+                break;
+
+            case ManagedBenchmark.ManagedToNativeCall:
+                for (var i = 0; i < iterations; i++)
+                {
+                    Core.NativeDelegates.Ping();
+                }
+                break;
+
+            case ManagedBenchmark.PropertyReadWrite:
+                Span<nint> objects = stackalloc nint[MaxPropertyObjects];
+                Span<nint> propertyBases = stackalloc nint[MaxPropertyObjects];
+
+                var count = Math.Min(ObjectQuery.Query(managedClass, objects, propertyBases), MaxPropertyObjects);
+
+                if (count == 0)
+                {
+                    return 0;
+                }
+
+                stopwatch.Restart();
+
+                // the same access pattern as generated properties have: read value of live UObject by pointer and write it back
+                for (var i = 0; i < iterations; i++)
+                {
+                    var properties = (int*)propertyBases[i % count];
+
+                    for (var property = 0; property < numProperties; property++)
+                    {
+                        properties[property] = properties[property] + 1;
+                    }
+                }
+                break;
+
+            default:
+                return 0;
+        }
+
+        return stopwatch.Elapsed.TotalSeconds;
+    }
+}
@@ -1,4 +1,5 @@
-﻿using System.Diagnostics.CodeAnalysis;
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
 using System.Reflection;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
@@ -22,16 +23,54 @@ internal static unsafe class Loader
         private readonly delegate* unmanaged[Cdecl]<void> _load = &Load;
         private readonly delegate* unmanaged[Cdecl]<void> _unload = &Unload;
         private readonly delegate* unmanaged[Cdecl]<void> _reload = &Reload;
+        private readonly delegate* unmanaged[Cdecl]<ManagedMemoryInfo*, nint, delegate* unmanaged[Cdecl]<nint, char*, int, long, int, void>, void> _getMemoryInfo = &GetMemoryInfo;
+        private readonly delegate* unmanaged[Cdecl]<void> _ping = &Ping;
+        private readonly delegate* unmanaged[Cdecl]<ManagedBenchmark, int, nint, int, double> _runBenchmark = &RunBenchmark;
+        private readonly delegate* unmanaged[Cdecl]<int> _getPendingReloads = &GetPendingReloads;
+        private readonly delegate* unmanaged[Cdecl]<int> _reloadPending = &ReloadPending;
+        private readonly delegate* unmanaged[Cdecl]<ManagedTraceEvents, void> _startTraceSession = &StartTraceSession;
+        private readonly delegate* unmanaged[Cdecl]<void> _stopTraceSession = &StopTraceSession;
+        private readonly delegate* unmanaged[Cdecl]<int, int, void> _configureThreadPool = &ConfigureThreadPool;
+        private readonly delegate* unmanaged[Cdecl]<int, void> _loadDeferredPlugin = &LoadDeferredPlugin;
+        private readonly delegate* unmanaged[Cdecl]<ManagedRuntimeState*, void> _getRuntimeState = &GetRuntimeState;
     }
 #pragma warning restore IDE0052, CA1823 // Remove unread private members, Avoid unused private fields
 
     [MemberNotNullWhen(true, nameof(_pluginsPath))]
     private static bool IsInitialized { get; set; }
 
+    private const string MetadataExtension = ".unetmeta";
+
     private static string? _pluginsPath;
 
+    /// <summary>
+    /// Whether loader and plugins are compiled into one NativeAOT library
+    /// </summary>
+    private static bool _isStaticallyLinked;
+
     private static readonly List<Plugin> _plugins = new();
 
+    /// <summary>
+    /// Paths of plugins loaded on demand, index is id of plugin known by native side, loaded ones are replaced by <see langword="null"/>
+    /// </summary>
+    private static readonly List<string?> _deferredPlugins = new();
+
+    /// <summary>
+    /// Process that hosts plugins, plugins that are not used by it are not loaded
+    /// </summary>
+    private static PluginTargets _hostTarget = PluginTargets.All;
+    private static string _hostPlatform = string.Empty;
+
+    private static PluginWatcher? _watcher;
+
+    /// <summary>
+    /// Plugins are rebuilt only while editor is running, packaged games and servers load them once from their files.
+    /// Statically linked plugins can't be reloaded at all
+    /// </summary>
+    private static bool IsHotReloadEnabled => !_isStaticallyLinked && _hostTarget == PluginTargets.Editor;
+
+    private static RuntimeTraceListener? _traceListener;
+
     private static event Action<Assembly>? OnPluginLoaded;
 
     private static void ReportUnhandledException(object sender, UnhandledExceptionEventArgs e)
@@ -49,7 +88,7 @@ internal static unsafe class Loader
 #pragma warning disable CS3016 // Arrays as attribute arguments is not CLS-compliant
 
     /// <summary>
-    /// Initializes UNET <see cref="Core"/>
+    /// Initializes UNET <see cref="Core"/> hosted by hostfxr
     /// </summary>
     /// <param name="pluginsPath">Path to directory with plugins</param>
     /// <param name="pathLength">Length of <paramref name="pluginsPath"/></param>
@@ -57,6 +96,138 @@ internal static unsafe class Loader
     /// <param name="loaderDelegates">Pointer to Core Plugin Loader functions that should be exposed</param>
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
     private static void Init(char* pluginsPath, int pathLength, IntPtr nativeDelegates, LoaderDelegates* loaderDelegates)
+        => Initialize(pluginsPath, pathLength, nativeDelegates, loaderDelegates, isStaticallyLinked: false);
+
+    /// <summary>
+    /// Initializes UNET <see cref="Core"/> compiled with NativeAOT, exported from shared library as <c>UNET_Init</c>
+    /// </summary>
+    /// <remarks>
+    /// Plugins are compiled into the same library, so they are not loaded from files
+    /// </remarks>
+    /// <inheritdoc cref="Init"/>
+    [UnmanagedCallersOnly(EntryPoint = "UNET_Init", CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void InitNativeAOT(char* pluginsPath, int pathLength, IntPtr nativeDelegates, LoaderDelegates* loaderDelegates)
+        => Initialize(pluginsPath, pathLength, nativeDelegates, loaderDelegates, isStaticallyLinked: true);
+
+    /// <summary>
+    /// Loads plugins
+    /// </summary>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void Load() => LoadPlugins();
+
+    /// <summary>
+    /// Unloads plugins
+    /// </summary>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void Unload() => UnloadPlugins();
+
+    /// <summary>
+    /// Reloads plugins
+    /// </summary>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void Reload() => ReloadPlugins();
+
+    /// <summary>
+    /// Collects managed heap and per-plugin memory usage
+    /// </summary>
+    /// <param name="info">Native structure to fill</param>
+    /// <param name="context">Native context passed back to <paramref name="pluginCallback"/></param>
+    /// <param name="pluginCallback">Native function called for each loaded plugin, can be null</param>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void GetMemoryInfo(ManagedMemoryInfo* info, nint context, delegate* unmanaged[Cdecl]<nint, char*, int, long, int, void> pluginCallback)
+        => MemoryReport.Collect(info, context, pluginCallback, _plugins);
+
+    /// <summary>
+    /// Collects GC and JIT counters, used to tell whether hitch in managed code was caused by runtime
+    /// </summary>
+    /// <param name="state">Native structure to fill</param>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void GetRuntimeState(ManagedRuntimeState* state) => ManagedRuntimeState.Capture(state);
+
+    /// <summary>
+    /// Does nothing, used to measure cost of native to managed call
+    /// </summary>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void Ping()
+    { }
+
+    /// <summary>
+    /// Runs benchmark of managed side of interop
+    /// </summary>
+    /// <param name="benchmark">Benchmark to run</param>
+    /// <param name="iterations">Count of iterations</param>
+    /// <param name="managedClass">Pointer to UClass of managed class which instances are used by benchmark</param>
+    /// <param name="numProperties">Count of <c>int</c> properties of <paramref name="managedClass"/></param>
+    /// <returns>Time of all iterations in seconds</returns>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static double RunBenchmark(ManagedBenchmark benchmark, int iterations, nint managedClass, int numProperties)
+        => Benchmarks.Run(benchmark, iterations, managedClass, numProperties);
+
+    /// <summary>
+    /// Returns count of plugins, which files were changed and can be reloaded
+    /// </summary>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static int GetPendingReloads() => _watcher?.PendingCount ?? 0;
+
+    /// <summary>
+    /// Reloads all plugins changed since previous reload as a single batch
+    /// </summary>
+    /// <returns>Count of reloaded plugins</returns>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static int ReloadPending() => ReloadChangedPlugins();
+
+    /// <summary>
+    /// Starts forwarding runtime events to Unreal Insights
+    /// </summary>
+    /// <param name="events">Categories of events to forward</param>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void StartTraceSession(ManagedTraceEvents events)
+    {
+        _traceListener?.Dispose();
+        _traceListener = new RuntimeTraceListener(events);
+
+        Debug.Log(ELogVerbosity.Display, $"Managed trace session is started ({events})");
+    }
+
+    /// <summary>
+    /// Stops forwarding runtime events
+    /// </summary>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void StopTraceSession()
+    {
+        _traceListener?.Dispose();
+        _traceListener = null;
+    }
+
+    /// <summary>
+    /// Limits count of .NET thread pool workers, so they don't oversubscribe cores used by engine
+    /// </summary>
+    /// <param name="minThreads">Minimal count of worker threads, 0 keeps current value</param>
+    /// <param name="maxThreads">Maximal count of worker threads, 0 keeps current value</param>
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void ConfigureThreadPool(int minThreads, int maxThreads)
+    {
+        if (minThreads <= 0 && maxThreads <= 0)
+        {
+            return;
+        }
+
+        ThreadPool.GetMinThreads(out var minWorkers, out var minCompletionPorts);
+        ThreadPool.GetMaxThreads(out var maxWorkers, out var maxCompletionPorts);
+
+        maxWorkers = maxThreads > 0 ? maxThreads : maxWorkers;
+        minWorkers = Math.Min(minThreads > 0 ? minThreads : minWorkers, maxWorkers);
+
+        // Minimum can't be above maximum and vice versa, so depending on direction one of them has to be applied first
+        var isApplied = ThreadPool.SetMinThreads(minWorkers, minCompletionPorts) & ThreadPool.SetMaxThreads(maxWorkers, maxCompletionPorts);
+        isApplied = isApplied || ThreadPool.SetMinThreads(minWorkers, minCompletionPorts) && ThreadPool.SetMaxThreads(maxWorkers, maxCompletionPorts);
+
+        Debug.Log(isApplied ? ELogVerbosity.Display : ELogVerbosity.Warning, isApplied
+            ? $"Thread pool is limited to {minWorkers}-{maxWorkers} worker threads"
+            : $"Failed to limit thread pool to {minWorkers}-{maxWorkers} worker threads");
+    }
+
+    private static void Initialize(char* pluginsPath, int pathLength, IntPtr nativeDelegates, LoaderDelegates* loaderDelegates, bool isStaticallyLinked)
     {
         if (IsInitialized)
         {
@@ -65,35 +236,86 @@ internal static unsafe class Loader
         }
 
         _pluginsPath = new string(pluginsPath, 0, pathLength);
+        _isStaticallyLinked = isStaticallyLinked;
+
         Core.Initialize(nativeDelegates);
+        Core.NativeDelegates.GetHostInfo(out _hostTarget, out _hostPlatform);
 
         OnPluginLoaded += PluginManager.Initialize;
         AppDomain.CurrentDomain.UnhandledException += ReportUnhandledException;
 
         *loaderDelegates = new();
 
-        Debug.Log(ELogVerbosity.Display, "Managed UNET Core is initialized");
+        Debug.Log(ELogVerbosity.Display, isStaticallyLinked
+            ? "Managed UNET Core is initialized (NativeAOT)"
+            : "Managed UNET Core is initialized");
 
         IsInitialized = true;
     }
 
     /// <summary>
-    /// Loads plugins
+    /// Loads plugin when one of classes declared in its manifest is requested for the first time
     /// </summary>
+    /// <param name="pluginId">Id passed to native side with classes of plugin</param>
     [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static void Load() => LoadPlugins();
+    private static void LoadDeferredPlugin(int pluginId)
+    {
+        var path = pluginId >= 0 && pluginId < _deferredPlugins.Count ? _deferredPlugins[pluginId] : null;
 
-    /// <summary>
-    /// Unloads plugins
-    /// </summary>
-    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static void Unload() => UnloadPlugins();
+        if (path is null)
+        {
+            Debug.Log(ELogVerbosity.Warning, $"Deferred plugin #{pluginId} is unknown or already loaded");
+            return;
+        }
 
-    /// <summary>
-    /// Reloads plugins
-    /// </summary>
-    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
-    private static void Reload() => ReloadPlugins();
+        _deferredPlugins[pluginId] = null;
+
+        // Class can be requested at any moment of the game, so failed load is reported instead of crashing it
+        try
+        {
+            LoadPlugin(path);
+        }
+        catch (Exception exception)
+        {
+            Debug.Log(ELogVerbosity.Error, $"Failed to load plugin '{Path.GetFileNameWithoutExtension(path)}' on demand: {exception.Message}");
+        }
+    }
+
+    private static int ReloadChangedPlugins()
+    {
+        if (_watcher is null)
+        {
+            return 0;
+        }
+
+        var plugins = _watcher.TakePending(out var waitTime);
+
+        if (plugins.Length == 0)
+        {
+            return 0;
+        }
+
+        var stopwatch = Stopwatch.StartNew();
+
+        foreach (var plugin in plugins)
+        {
+            // Handlers point to code of plugin, so it binds them again after reload
+            if (plugin.Assembly?.GetName().Name is { } owner)
+            {
+                Core.NativeDelegates.UnbindOwnedDelegates(owner);
+            }
+
+            plugin.Reload();
+        }
+
+        var reloadTime = stopwatch.Elapsed;
+
+        Debug.Log(ELogVerbosity.Display,
+            $"Reloaded {plugins.Length} plugin(s) ({string.Join(", ", plugins.Select(plugin => plugin.Name))}) in {reloadTime.TotalMilliseconds:F2} ms, " +
+            $"{(waitTime + reloadTime).TotalMilliseconds:F2} ms after the first change");
+
+        return plugins.Length;
+    }
 
     private static void ReloadPlugins()
     {
@@ -110,6 +332,13 @@ internal static unsafe class Loader
             throw new NotInitializedException();
         }
 
+        var stopwatch = Stopwatch.StartNew();
+        var heapBytes = GC.GetTotalMemory(forceFullCollection: false);
+        var workingSetBytes = Environment.WorkingSet;
+        var loadedBytes = 0L;
+        var skippedPlugins = new List<(string Name, long Bytes)>();
+        var deferredClasses = 0;
+
         foreach (var path in Directory.EnumerateFiles(_pluginsPath, "*.unetplugin", SearchOption.AllDirectories))
         {
             if (!File.Exists(path))
@@ -117,29 +346,139 @@ internal static unsafe class Loader
                 throw new FileNotFoundException($"Plugin '{Path.GetFileNameWithoutExtension(path)}' not found");
             }
 
-            LoadPlugin(path);
+            var bytes = new FileInfo(path).Length;
+            var manifest = PluginManifest.Load(path);
+
+            if (!manifest.IsUsedBy(_hostTarget, _hostPlatform))
+            {
+                skippedPlugins.Add((Path.GetFileNameWithoutExtension(path), bytes));
+                continue;
+            }
+
+            // Editor lists all classes in pickers and Blueprint parents, so it loads everything
+            if (manifest.LoadOnDemand && _hostTarget != PluginTargets.Editor)
+            {
+                DeferPlugin(path, manifest);
+                deferredClasses += manifest.Classes.Length;
+                continue;
+            }
+
+            if (LoadPlugin(path))
+            {
+                loadedBytes += bytes;
+            }
         }
+
+        ReportSkippedPlugins(skippedPlugins, loadedBytes, stopwatch.Elapsed);
+        ReportLoadModes(GC.GetTotalMemory(forceFullCollection: false) - heapBytes, Environment.WorkingSet - workingSetBytes);
+
+        if (_deferredPlugins.Count > 0)
+        {
+            Debug.Log(ELogVerbosity.Display, $"{_deferredPlugins.Count} plugin(s) with {deferredClasses} class(es) will be loaded on demand");
+        }
+
+        if (IsHotReloadEnabled)
+        {
+            // Previous watcher would keep raising events for the same directory
+            _watcher?.Dispose();
+            _watcher = new PluginWatcher(_pluginsPath, _plugins);
+        }
+    }
+
+    private static void DeferPlugin(string path, PluginManifest manifest)
+    {
+        var pluginId = _deferredPlugins.Count;
+        _deferredPlugins.Add(path);
+
+        foreach (var className in manifest.Classes)
+        {
+            Core.NativeDelegates.RegisterDeferredClass(className, pluginId);
+        }
+    }
+
+    private static void ReportLoadModes(long heapDelta, long workingSetDelta)
+    {
+        var original = _plugins.Count(plugin => plugin.LoadMode == PluginLoadMode.Original);
+        var shadowCopied = _plugins.Where(plugin => plugin.LoadMode == PluginLoadMode.ShadowCopy).ToArray();
+        var inMemory = _plugins.Count(plugin => plugin.LoadMode == PluginLoadMode.InMemory);
+
+        if (original == 0 && shadowCopied.Length == 0 && inMemory == 0)
+        {
+            return;
+        }
+
+        // Growth is measured for all plugins together, it is not split between modes
+        Debug.Log(ELogVerbosity.Display,
+            $"{original} plugin(s) are loaded from original files, {shadowCopied.Length} from shadow copies ({shadowCopied.Sum(plugin => plugin.MappedBytes) / 1024.0:F1} KB mapped from files), " +
+            $"{inMemory} in memory; managed heap grew by {heapDelta / 1024.0:F1} KB, working set by {workingSetDelta / 1024.0:F1} KB");
     }
 
-    private static void LoadPlugin(string path)
+    private static void ReportSkippedPlugins(List<(string Name, long Bytes)> skippedPlugins, long loadedBytes, TimeSpan loadTime)
     {
-        var plugin = new Plugin(path);
+        if (skippedPlugins.Count == 0)
+        {
+            return;
+        }
+
+        var skippedBytes = skippedPlugins.Sum(plugin => plugin.Bytes);
+
+        // Load time of skipped plugins is unknown, so it is estimated from loaded ones by size of their assemblies
+        var savedTime = loadedBytes > 0 ? loadTime * ((double)skippedBytes / loadedBytes) : TimeSpan.Zero;
+
+        Debug.Log(ELogVerbosity.Display,
+            $"Skipped {skippedPlugins.Count} plugin(s) not used by {_hostTarget} on {_hostPlatform} ({string.Join(", ", skippedPlugins.Select(plugin => plugin.Name))}), " +
+            $"{skippedBytes / 1024.0:F1} KB not loaded, ~{savedTime.TotalMilliseconds:F2} ms saved");
+    }
+
+    /// <returns><see langword="false"/> when plugin is not used by current process and was unloaded</returns>
+    private static bool LoadPlugin(string path)
+    {
+        var plugin = _isStaticallyLinked ? Plugin.FromStaticallyLinked(path) : new Plugin(path, IsHotReloadEnabled);
 
         if (!plugin.IsLoaded)
         {
             throw new FileLoadException($"Failed to load plugin from {path}");
         }
 
-        if (!plugin.Assembly.IsDefined(typeof(PluginAttribute)))
+        var attribute = plugin.Assembly.GetCustomAttribute<PluginAttribute>();
+
+        if (attribute is null)
         {
             throw new FileLoadException($"'{plugin.Assembly.GetName().Name}' is not a Core plugin");
         }
 
+        if (!attribute.Targets.HasFlag(_hostTarget))
+        {
+            Debug.Log(ELogVerbosity.Log, $"Plugin '{plugin.Name}' is not used by {_hostTarget} and is unloaded, add {PluginManifest.Extension} file to skip it without loading");
+            plugin.Unload();
+            return false;
+        }
+
         _plugins.Add(plugin);
+        _watcher?.Add(plugin);
 
         plugin.Reloaded += OnPluginReloaded;
 
-        OnPluginLoaded?.Invoke(plugin.Assembly);
+        InitializePlugin(plugin, plugin.Assembly);
+        return true;
+    }
+
+    private static void InitializePlugin(Plugin plugin, Assembly assembly)
+    {
+        // Precompiled metadata is linked by native side, so class infos are not built in managed code at all
+        var metadataPath = Path.ChangeExtension(plugin.FilePath, MetadataExtension);
+
+        if (File.Exists(metadataPath))
+        {
+            if (PluginManager.Initialize(assembly, metadataPath))
+            {
+                return;
+            }
+
+            Debug.Log(ELogVerbosity.Warning, $"Precompiled metadata of '{plugin.Name}' can't be used, metadata provider will be used instead");
+        }
+
+        OnPluginLoaded?.Invoke(assembly);
     }
 
     private static void OnPluginReloaded(Plugin plugin)
@@ -150,15 +489,22 @@ internal static unsafe class Loader
         }
 
         PluginManager.Refresh(plugin.Assembly);
+
+        // Classes are registered again, native side reuses the ones which layout wasn't changed
+        InitializePlugin(plugin, plugin.Assembly);
     }
 
     private static void UnloadPlugins()
     {
+        _watcher?.Dispose();
+        _watcher = null;
+
         foreach (var plugin in _plugins)
         {
             plugin.Unload();
         }
 
         _plugins.Clear();
+        _deferredPlugins.Clear();
     }
 }
\ No newline at end of file
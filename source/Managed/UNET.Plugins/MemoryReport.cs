@@ -0,0 +1,97 @@
+﻿using System.Runtime.InteropServices;
+using System.Runtime.Loader;
+
+namespace UNET.Plugins;
+
+/// <summary>
+/// Managed heap snapshot, layout must match <c>UNET::FManagedMemoryInfo</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal unsafe struct ManagedMemoryInfo
+{
+    public long GCIndex;
+    public long HeapSizeBytes;
+    public long CommittedBytes;
+    public long FragmentedBytes;
+    public fixed long GenerationSizeBytes[3];
+    public long LargeObjectHeapSizeBytes;
+    public long PinnedObjectHeapSizeBytes;
+    public long PinnedObjectsCount;
+}
+
+internal static unsafe class MemoryReport
+{
+    private const int LargeObjectHeapIndex = 3;
+    private const int PinnedObjectHeapIndex = 4;
+
+    /// <summary>
+    /// Fills <paramref name="info"/> with managed heap state and reports size of assembly images loaded by each plugin
+    /// </summary>
+    /// <remarks>
+    /// .NET doesn't track heap usage per <see cref="AssemblyLoadContext"/>, so reported size is only the size of image files
+    /// loaded into plugin context, read from shadow copy when plugin is shadow copied. Symbols are not counted, they aren't loaded with images
+    /// </remarks>
+    public static void Collect(
+        ManagedMemoryInfo* info,
+        nint context,
+        delegate* unmanaged[Cdecl]<nint, char*, int, long, int, void> pluginCallback,
+        IEnumerable<Plugin> plugins)
+    {
+        var gcInfo = GC.GetGCMemoryInfo(GCKind.Any);
+        var generations = gcInfo.GenerationInfo;
+
+        info->GCIndex = gcInfo.Index;
+        info->HeapSizeBytes = gcInfo.HeapSizeBytes;
+        info->CommittedBytes = gcInfo.TotalCommittedBytes;
+        info->FragmentedBytes = gcInfo.FragmentedBytes;
+
+        for (var generation = 0; generation < 3 && generation < generations.Length; generation++)
+        {
+            info->GenerationSizeBytes[generation] = generations[generation].SizeAfterBytes;
+        }
+
+        info->LargeObjectHeapSizeBytes = generations.Length > LargeObjectHeapIndex ? generations[LargeObjectHeapIndex].SizeAfterBytes : 0;
+        info->PinnedObjectHeapSizeBytes = generations.Length > PinnedObjectHeapIndex ? generations[PinnedObjectHeapIndex].SizeAfterBytes : 0;
+        info->PinnedObjectsCount = gcInfo.PinnedObjectsCount;
+
+        if (pluginCallback is null)
+        {
+            return;
+        }
+
+        foreach (var plugin in plugins)
+        {
+            // Code of statically linked plugins is a part of NativeAOT image, so there is nothing to attribute to them
+            if (!plugin.IsLoaded || plugin.IsStaticallyLinked)
+            {
+                continue;
+            }
+
+            var assemblies = plugin.Context.Assemblies.ToArray();
+            var bytes = assemblies.Sum(assembly => GetImageSize(assembly, plugin));
+            var name = plugin.Name;
+
+            fixed (char* namePtr = name)
+            {
+                pluginCallback(context, namePtr, name.Length, bytes, assemblies.Length);
+            }
+        }
+    }
+
+    private static long GetImageSize(System.Reflection.Assembly assembly, Plugin plugin)
+    {
+        // Assemblies loaded in memory have no location, so their size is taken from original files they were read from
+        var path = assembly.Location;
+
+        if (string.IsNullOrEmpty(path))
+        {
+            path = assembly == plugin.Assembly
+                ? plugin.FilePath
+                : Path.Combine(plugin.Directory, $"{assembly.GetName().Name}.dll");
+        }
+
+        var image = new FileInfo(path);
+
+        return image.Exists ? image.Length : 0;
+    }
+}
@@ -4,24 +4,49 @@ using System.Runtime.Loader;
 
 using McMaster.NETCore.Plugins;
 
+using UNET.Interop;
+
 namespace UNET.Plugins;
 
+/// <summary>
+/// How assemblies of plugin are loaded into its context
+/// </summary>
+internal enum PluginLoadMode
+{
+    /// <summary>
+    /// Loaded from original files, used when plugins are not reloaded, so nothing has to rebuild them while they are locked
+    /// </summary>
+    Original,
+
+    /// <summary>
+    /// Loaded from files copied to temporary directory, so runtime maps them and original files stay writable
+    /// </summary>
+    ShadowCopy,
+
+    /// <summary>
+    /// Read into memory, used when shadow copy can't be created
+    /// </summary>
+    InMemory,
+
+    /// <summary>
+    /// Compiled into NativeAOT library
+    /// </summary>
+    StaticallyLinked,
+}
+
 internal sealed class Plugin
 {
-    internal Plugin(string path)
+    /// <param name="path">Path to <c>.unetplugin</c> file</param>
+    /// <param name="isReloadable">Whether plugin is reloaded when its files are changed, only then files are copied before load</param>
+    internal Plugin(string path, bool isReloadable)
     {
-        var config = new PluginConfig(path)
-        {
-            // We can define shared must-have assemblies in UNET.Plugins project references,
-            // because DefaultContext is context of this assembly
-            PreferSharedTypes = true,
+        FilePath = path;
+        Name = Path.GetFileNameWithoutExtension(path);
+        Directory = Path.GetDirectoryName(path)!;
 
-            EnableHotReload = true,
-            IsUnloadable = true,
-            LoadInMemory = true,
-        };
+        _isReloadable = isReloadable;
 
-        Loader = new PluginLoader(config);
+        Loader = CreateLoader();
 
         Assembly = Loader.LoadDefaultAssembly();
         Context = AssemblyLoadContext.GetLoadContext(Assembly)!;
@@ -34,12 +59,51 @@ internal sealed class Plugin
         IsLoaded = true;
     }
 
+    private Plugin(string path, Assembly assembly)
+    {
+        FilePath = path;
+        Name = Path.GetFileNameWithoutExtension(path);
+        Directory = Path.GetDirectoryName(path)!;
+
+        Assembly = assembly;
+        Context = AssemblyLoadContext.Default;
+
+        _contextReference = new WeakReference(Context);
+
+        IsStaticallyLinked = true;
+        LoadMode = PluginLoadMode.StaticallyLinked;
+        IsLoaded = true;
+    }
+
+    /// <summary>
+    /// Creates plugin, which is compiled into the same NativeAOT library as loader
+    /// </summary>
+    /// <param name="path">Path to <c>.unetplugin</c> file, only its name is used to find assembly</param>
+    internal static Plugin FromStaticallyLinked(string path)
+    {
+        var name = new AssemblyName(Path.GetFileNameWithoutExtension(path));
+
+        try
+        {
+            return new Plugin(path, Assembly.Load(name));
+        }
+        catch (FileNotFoundException exception)
+        {
+            throw new FileLoadException($"Plugin '{name.Name}' is not compiled into NativeAOT library", exception);
+        }
+    }
+
     [MemberNotNullWhen(true, nameof(Context))]
     [MemberNotNullWhen(true, nameof(Assembly))]
     [MemberNotNullWhen(true, nameof(_contextReference))]
-    [MemberNotNullWhen(true, nameof(Loader))]
     public bool IsLoaded { get; private set; }
 
+    /// <summary>
+    /// Statically linked plugins live in default context and can't be unloaded or reloaded
+    /// </summary>
+    [MemberNotNullWhen(false, nameof(Loader))]
+    public bool IsStaticallyLinked { get; }
+
     internal event Action<Plugin>? Reloaded;
 
     internal event Action<Plugin>? ReloadFailed;
@@ -50,13 +114,82 @@ internal sealed class Plugin
 
     private WeakReference? _contextReference;
 
+    /// <summary>
+    /// Path to <c>.unetplugin</c> file
+    /// </summary>
+    public string FilePath { get; }
+
+    public string Name { get; }
+
+    public string Directory { get; }
+
     public AssemblyLoadContext? Context { get; private set; }
 
-    public PluginLoader? Loader { get; }
+    public PluginLoader? Loader { get; private set; }
 
     public Assembly? Assembly { get; private set; }
 
-    private void OnReloaded(object sender, PluginReloadedEventArgs eventArgs) => Reloaded?.Invoke(this);
+    public PluginLoadMode LoadMode { get; private set; }
+
+    /// <summary>
+    /// Size of assembly images mapped from shadow copy, that would be read into memory otherwise
+    /// </summary>
+    public long MappedBytes => _shadowCopy?.ImageBytes ?? 0;
+
+    private readonly bool _isReloadable;
+
+    private ShadowCopy? _shadowCopy;
+
+    private PluginLoader CreateLoader()
+    {
+        _shadowCopy = null;
+        LoadMode = PluginLoadMode.Original;
+
+        if (_isReloadable)
+        {
+            try
+            {
+                _shadowCopy = ShadowCopy.Create(FilePath);
+                LoadMode = PluginLoadMode.ShadowCopy;
+            }
+            catch (Exception exception) when (exception is IOException or UnauthorizedAccessException)
+            {
+                Debug.Log(ELogVerbosity.Warning, $"Shadow copy of plugin '{Name}' can't be created, it is loaded in memory: {exception.Message}");
+
+                LoadMode = PluginLoadMode.InMemory;
+            }
+        }
+
+        var config = new PluginConfig(_shadowCopy?.PluginPath ?? FilePath)
+        {
+            // We can define shared must-have assemblies in UNET.Plugins project references,
+            // because DefaultContext is context of this assembly
+            PreferSharedTypes = true,
+
+            // Changes are tracked by single PluginWatcher for all plugins
+            EnableHotReload = false,
+            IsUnloadable = true,
+
+            // Loading reloadable plugin from original files would lock them on Windows, so they are read into memory only without a copy
+            LoadInMemory = LoadMode == PluginLoadMode.InMemory,
+        };
+
+        return new PluginLoader(config);
+    }
+
+    private void OnReloaded(object sender, PluginReloadedEventArgs eventArgs) => OnReloaded();
+
+    private void OnReloaded()
+    {
+        // Loader has created new context, so everything that pointed to the old one is replaced
+        Assembly = Loader!.LoadDefaultAssembly();
+        Context = AssemblyLoadContext.GetLoadContext(Assembly)!;
+        Context.Unloading += OnUnloading;
+
+        _contextReference = new WeakReference(Context);
+
+        Reloaded?.Invoke(this);
+    }
 
     private void OnUnloading(AssemblyLoadContext context) => Unloading?.Invoke(this);
 
@@ -74,6 +207,16 @@ internal sealed class Plugin
         }
 
         Assembly = null;
+
+        if (IsStaticallyLinked)
+        {
+            Context = null;
+            _contextReference = null;
+
+            OnUnloaded();
+            return;
+        }
+
         Context.Unload();
 
         Context = null;
@@ -88,17 +231,45 @@ internal sealed class Plugin
 
         _contextReference = null;
 
+        _shadowCopy?.Dispose();
+        _shadowCopy = null;
+
         OnUnloaded();
     }
 
     internal void Reload()
     {
-        if (!IsLoaded)
+        if (!IsLoaded || IsStaticallyLinked)
         {
             ReloadFailed?.Invoke(this);
             return;
         }
 
-        Loader.Reload();
+        if (LoadMode != PluginLoadMode.ShadowCopy)
+        {
+            Loader.Reload();
+            return;
+        }
+
+        // Shadow copy is a snapshot of files, so changed ones are copied again into a new directory
+        var previousCopy = _shadowCopy;
+
+        Loader.Dispose();
+
+        Assembly = null;
+        Context = null;
+
+        Loader = CreateLoader();
+        Loader.Reloaded += OnReloaded;
+
+        if (_contextReference.IsAlive)
+        {
+            GC.Collect(GC.MaxGeneration, GCCollectionMode.Forced);
+            GC.WaitForPendingFinalizers();
+        }
+
+        previousCopy?.Dispose();
+
+        OnReloaded();
     }
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+﻿using System.Text.Json;
+
+namespace UNET.Plugins;
+
+/// <summary>
+/// Optional <c>.unetmanifest</c> file next to plugin, read before plugin assembly is loaded
+/// </summary>
+/// <example>
+/// <code>
+/// {
+///     "Targets": [ "Editor", "Game", "Client" ],
+///     "Platforms": [ "Windows", "Mac" ],
+///     "LoadOnDemand": true,
+///     "Classes": [ "MyActor", "MyComponent" ]
+/// }
+/// </code>
+/// </example>
+internal sealed class PluginManifest
+{
+    public const string Extension = ".unetmanifest";
+
+    public static PluginManifest Default { get; } = new(PluginTargets.All, Array.Empty<string>(), false, Array.Empty<string>());
+
+    private PluginManifest(PluginTargets targets, string[] platforms, bool loadOnDemand, string[] classes)
+    {
+        Targets = targets;
+        Platforms = platforms;
+        LoadOnDemand = loadOnDemand;
+        Classes = classes;
+    }
+
+    public PluginTargets Targets { get; }
+
+    /// <summary>
+    /// Names of platforms used by UE ini files, empty when plugin is used on all platforms
+    /// </summary>
+    public string[] Platforms { get; }
+
+    /// <summary>
+    /// Whether plugin is loaded only when one of <see cref="Classes"/> is requested
+    /// </summary>
+    public bool LoadOnDemand { get; }
+
+    /// <summary>
+    /// Names of UClasses registered by plugin, without prefix
+    /// </summary>
+    public string[] Classes { get; }
+
+    public bool IsUsedBy(PluginTargets target, string platform)
+        => Targets.HasFlag(target) &&
+        (Platforms.Length == 0 || Platforms.Contains(platform, StringComparer.OrdinalIgnoreCase));
+
+    /// <summary>
+    /// Reads manifest of plugin, or returns <see cref="Default"/> when plugin has no manifest
+    /// </summary>
+    /// <param name="pluginPath">Path to <c>.unetplugin</c> file</param>
+    /// <exception cref="FormatException">Manifest is not valid</exception>
+    public static PluginManifest Load(string pluginPath)
+    {
+        var path = Path.ChangeExtension(pluginPath, Extension);
+
+        if (!File.Exists(path))
+        {
+            return Default;
+        }
+
+        // JsonDocument doesn't need reflection, so manifest can be read in trimmed and NativeAOT builds
+        using var document = JsonDocument.Parse(File.ReadAllBytes(path));
+        var root = document.RootElement;
+
+        var targets = PluginTargets.All;
+        var platforms = Array.Empty<string>();
+        var loadOnDemand = false;
+        var classes = Array.Empty<string>();
+
+        if (root.TryGetProperty("Targets", out var targetsElement))
+        {
+            targets = PluginTargets.None;
+
+            foreach (var target in targetsElement.EnumerateArray())
+            {
+                if (!Enum.TryParse<PluginTargets>(target.GetString(), ignoreCase: true, out var parsed))
+                {
+                    throw new FormatException($"Unknown target '{target}' in {path}");
+                }
+
+                targets |= parsed;
+            }
+        }
+
+        if (root.TryGetProperty("Platforms", out var platformsElement))
+        {
+            platforms = platformsElement.EnumerateArray().Select(platform => platform.GetString() ?? string.Empty).ToArray();
+        }
+
+        if (root.TryGetProperty("LoadOnDemand", out var loadOnDemandElement))
+        {
+            loadOnDemand = loadOnDemandElement.GetBoolean();
+        }
+
+        if (root.TryGetProperty("Classes", out var classesElement))
+        {
+            classes = classesElement.EnumerateArray().Select(name => name.GetString() ?? string.Empty).Where(name => name.Length > 0).ToArray();
+        }
+
+        // Plugin without declared classes would never be requested
+        if (loadOnDemand && classes.Length == 0)
+        {
+            throw new FormatException($"Plugin loaded on demand must declare its classes in {path}");
+        }
+
+        return new PluginManifest(targets, platforms, loadOnDemand, classes);
+    }
+}
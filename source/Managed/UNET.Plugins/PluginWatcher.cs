@@ -0,0 +1,178 @@
+﻿using System.Diagnostics;
+
+namespace UNET.Plugins;
+
+/// <summary>
+/// Watches the whole managed plugins directory and collects plugins that have to be reloaded
+/// </summary>
+/// <remarks>
+/// Build writes many files of a plugin in a row, so changes are coalesced until directory is quiet for <see cref="DebounceDelay"/>.
+/// Watcher only collects changes, reload itself is requested by native side on game thread.
+/// </remarks>
+internal sealed class PluginWatcher : IDisposable
+{
+    private static readonly TimeSpan DebounceDelay = TimeSpan.FromMilliseconds(300);
+
+    private static readonly string[] WatchedExtensions = { ".dll", ".unetplugin", ".unetmeta", ".json" };
+
+    private readonly FileSystemWatcher _watcher;
+
+    private readonly Timer _debounceTimer;
+
+    // Own copy, plugins loaded on demand are added while watcher events are handled on other threads
+    private readonly List<Plugin> _plugins;
+
+    private readonly object _sync = new();
+
+    private readonly HashSet<Plugin> _changedPlugins = new();
+
+    private long _firstChangeTimestamp;
+
+    private bool _isQuiet;
+
+    public PluginWatcher(string path, IReadOnlyList<Plugin> plugins)
+    {
+        _plugins = new List<Plugin>(plugins);
+        _debounceTimer = new Timer(OnDebounceElapsed);
+
+        _watcher = new FileSystemWatcher(path)
+        {
+            IncludeSubdirectories = true,
+            NotifyFilter = NotifyFilters.FileName | NotifyFilters.LastWrite | NotifyFilters.Size,
+        };
+
+        _watcher.Changed += OnChanged;
+        _watcher.Created += OnChanged;
+        _watcher.Deleted += OnChanged;
+        _watcher.Renamed += OnChanged;
+        _watcher.Error += OnError;
+
+        _watcher.EnableRaisingEvents = true;
+    }
+
+    /// <summary>
+    /// Count of plugins, which files were changed and are not being written anymore
+    /// </summary>
+    public int PendingCount
+    {
+        get
+        {
+            lock (_sync)
+            {
+                return _isQuiet ? _changedPlugins.Count : 0;
+            }
+        }
+    }
+
+    public void Add(Plugin plugin)
+    {
+        lock (_sync)
+        {
+            _plugins.Add(plugin);
+        }
+    }
+
+    /// <summary>
+    /// Takes plugins collected since previous call, if directory is quiet
+    /// </summary>
+    /// <param name="elapsed">Time since the first change in batch</param>
+    public Plugin[] TakePending(out TimeSpan elapsed)
+    {
+        lock (_sync)
+        {
+            if (!_isQuiet || _changedPlugins.Count == 0)
+            {
+                elapsed = TimeSpan.Zero;
+                return Array.Empty<Plugin>();
+            }
+
+            var plugins = _changedPlugins.ToArray();
+
+            elapsed = TimeSpan.FromSeconds((double)(Stopwatch.GetTimestamp() - _firstChangeTimestamp) / Stopwatch.Frequency);
+
+            _changedPlugins.Clear();
+            _isQuiet = false;
+
+            return plugins;
+        }
+    }
+
+    private void OnChanged(object sender, FileSystemEventArgs e)
+    {
+        if (!WatchedExtensions.Contains(Path.GetExtension(e.FullPath), StringComparer.OrdinalIgnoreCase))
+        {
+            return;
+        }
+
+        lock (_sync)
+        {
+            AddChanged(FindAffected(e.FullPath));
+        }
+    }
+
+    // Events were lost, so it is unknown what was changed
+    private void OnError(object sender, ErrorEventArgs e) => AddChanged(_plugins);
+
+    private void AddChanged(IEnumerable<Plugin> plugins)
+    {
+        lock (_sync)
+        {
+            var wasEmpty = _changedPlugins.Count == 0;
+
+            foreach (var plugin in plugins)
+            {
+                _changedPlugins.Add(plugin);
+            }
+
+            if (_changedPlugins.Count == 0)
+            {
+                return;
+            }
+
+            if (wasEmpty)
+            {
+                _firstChangeTimestamp = Stopwatch.GetTimestamp();
+            }
+
+            _isQuiet = false;
+            _debounceTimer.Change(DebounceDelay, Timeout.InfiniteTimeSpan);
+        }
+    }
+
+    private void OnDebounceElapsed(object? state)
+    {
+        lock (_sync)
+        {
+            _isQuiet = true;
+        }
+    }
+
+    private IEnumerable<Plugin> FindAffected(string path)
+    {
+        var name = Path.GetFileNameWithoutExtension(path);
+
+        // Assembly of plugin itself, its metadata or .unetplugin file
+        var plugin = _plugins.FirstOrDefault(plugin => string.Equals(plugin.Name, name, StringComparison.OrdinalIgnoreCase));
+
+        if (plugin is not null)
+        {
+            return new[] { plugin };
+        }
+
+        // Dependency, that can be used by any plugin from its directory
+        return _plugins.Where(plugin => IsInDirectory(path, plugin.Directory));
+    }
+
+    private static bool IsInDirectory(string path, string directory)
+    {
+        var relativePath = Path.GetRelativePath(directory, path);
+
+        return !relativePath.StartsWith("..", StringComparison.Ordinal) && !Path.IsPathRooted(relativePath);
+    }
+
+    public void Dispose()
+    {
+        _watcher.Dispose();
+        _debounceTimer.Dispose();
+    }
+}
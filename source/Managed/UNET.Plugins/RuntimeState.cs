@@ -0,0 +1,34 @@
+﻿using System.Runtime;
+using System.Runtime.InteropServices;
+
+namespace UNET.Plugins;
+
+/// <summary>
+/// Cumulative GC and JIT counters, layout must match <c>UNET::FManagedRuntimeState</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal unsafe struct ManagedRuntimeState
+{
+    public fixed long GCCounts[3];
+    public long AllocatedBytes;
+    public long JitCompiledMethods;
+    public long JitTimeTicks;
+
+    /// <summary>
+    /// Fills <paramref name="state"/> with counters of the whole runtime
+    /// </summary>
+    /// <remarks>
+    /// Called by hitch detector from its own thread, so only counters that don't suspend runtime are read
+    /// </remarks>
+    public static void Capture(ManagedRuntimeState* state)
+    {
+        for (var generation = 0; generation < 3; generation++)
+        {
+            state->GCCounts[generation] = GC.CollectionCount(generation);
+        }
+
+        state->AllocatedBytes = GC.GetTotalAllocatedBytes(false);
+        state->JitCompiledMethods = JitInfo.GetCompiledMethodCount(false);
+        state->JitTimeTicks = JitInfo.GetCompilationTime(false).Ticks;
+    }
+}
@@ -0,0 +1,209 @@
+﻿using System.Diagnostics.Tracing;
+using System.Runtime.InteropServices;
+
+namespace UNET.Plugins;
+
+/// <summary>
+/// Categories of runtime events forwarded to Unreal Insights, values must match <c>EUNETManagedTraceEvents</c>
+/// </summary>
+[Flags]
+internal enum ManagedTraceEvents
+{
+    None = 0,
+    GC = 1 << 0,
+    Jit = 1 << 1,
+    Exceptions = 1 << 2,
+    ThreadPool = 1 << 3
+}
+
+/// <summary>
+/// Kind of forwarded event, values must match <c>UNET::EManagedTraceEvent</c>
+/// </summary>
+internal enum ManagedTraceEventType
+{
+    GCPause,
+    JitCompilation,
+    Exception,
+    ThreadPoolWorkers
+}
+
+/// <summary>
+/// Single runtime event, layout must match <c>UNET::FManagedTraceEvent</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal unsafe struct ManagedTraceEvent
+{
+    public ManagedTraceEventType Type;
+    public int Value;
+    public double SecondsAgo;
+    public double DurationSeconds;
+    public char* Name;
+    public int NameLength;
+}
+
+/// <summary>
+/// In-process EventPipe session over .NET runtime provider, that forwards its events to native side
+/// </summary>
+/// <remarks>
+/// Events are dispatched by runtime on its own thread in batches, so their age is measured from event timestamps.
+/// Method sampling is done by <c>Microsoft-DotNETCore-SampleProfiler</c>, that is available only to out-of-process sessions.
+/// </remarks>
+internal sealed unsafe class RuntimeTraceListener : EventListener
+{
+    private const string RuntimeSourceName = "Microsoft-Windows-DotNETRuntime";
+
+    // Keywords and IDs of runtime provider events, see ClrEtwAll.man in dotnet/runtime
+    private const EventKeywords GCKeyword = (EventKeywords)0x1;
+    private const EventKeywords JitKeyword = (EventKeywords)0x10;
+    private const EventKeywords ExceptionKeyword = (EventKeywords)0x8000;
+    private const EventKeywords ThreadingKeyword = (EventKeywords)0x10000;
+
+    private const int GCStartId = 1;
+    private const int GCRestartEEEndId = 3;
+    private const int GCSuspendEEBeginId = 9;
+    private const int ThreadPoolWorkerThreadStartId = 50;
+    private const int ThreadPoolWorkerThreadStopId = 51;
+    private const int ThreadPoolWorkerThreadAdjustmentId = 55;
+    private const int ExceptionThrownId = 80;
+    private const int MethodLoadVerboseId = 143;
+    private const int MethodJittingStartedId = 145;
+
+    private readonly ManagedTraceEvents _events;
+
+    private EventSource? _runtimeSource;
+
+    // Events of runtime provider come from a single dispatch thread, so state below isn't locked
+    private DateTime? _suspensionStart;
+    private int _collectedGeneration = -1;
+    private readonly Dictionary<ulong, DateTime> _jittingStarts = new();
+
+    public RuntimeTraceListener(ManagedTraceEvents events)
+    {
+        _events = events;
+
+        // Runtime source already exists, so it is reported from base constructor before events are assigned
+        if (_runtimeSource is not null)
+        {
+            EnableRuntimeEvents(_runtimeSource);
+        }
+    }
+
+    protected override void OnEventSourceCreated(EventSource eventSource)
+    {
+        if (eventSource.Name != RuntimeSourceName)
+        {
+            return;
+        }
+
+        _runtimeSource = eventSource;
+
+        if (_events != ManagedTraceEvents.None)
+        {
+            EnableRuntimeEvents(eventSource);
+        }
+    }
+
+    private void EnableRuntimeEvents(EventSource eventSource)
+    {
+        var keywords = EventKeywords.None;
+
+        if (_events.HasFlag(ManagedTraceEvents.GC))
+        {
+            keywords |= GCKeyword;
+        }
+
+        if (_events.HasFlag(ManagedTraceEvents.Jit))
+        {
+            keywords |= JitKeyword;
+        }
+
+        if (_events.HasFlag(ManagedTraceEvents.Exceptions))
+        {
+            keywords |= ExceptionKeyword;
+        }
+
+        if (_events.HasFlag(ManagedTraceEvents.ThreadPool))
+        {
+            keywords |= ThreadingKeyword;
+        }
+
+        // Method names of JIT events are written only with verbose level
+        EnableEvents(eventSource, EventLevel.Verbose, keywords);
+    }
+
+    protected override void OnEventWritten(EventWrittenEventArgs eventData)
+    {
+        switch (eventData.EventId)
+        {
+            case GCSuspendEEBeginId:
+                _suspensionStart = eventData.TimeStamp;
+                _collectedGeneration = -1;
+                break;
+
+            case GCStartId:
+                _collectedGeneration = GetPayload<uint>(eventData, "Depth") is { } depth ? (int)depth : -1;
+                break;
+
+            case GCRestartEEEndId when _suspensionStart is { } suspensionStart:
+                _suspensionStart = null;
+                Trace(ManagedTraceEventType.GCPause, _collectedGeneration, eventData.TimeStamp, eventData.TimeStamp - suspensionStart);
+                break;
+
+            case MethodJittingStartedId when GetPayload<ulong>(eventData, "MethodID") is { } methodId:
+                _jittingStarts[methodId] = eventData.TimeStamp;
+                break;
+
+            // Precompiled methods are loaded without jitting, so there is nothing to report for them
+            case MethodLoadVerboseId when GetPayload<ulong>(eventData, "MethodID") is { } methodId && _jittingStarts.Remove(methodId, out var jittingStart):
+                var methodName = $"{GetPayloadString(eventData, "MethodNamespace")}.{GetPayloadString(eventData, "MethodName")}";
+                Trace(ManagedTraceEventType.JitCompilation, 0, eventData.TimeStamp, eventData.TimeStamp - jittingStart, methodName);
+                break;
+
+            case ExceptionThrownId:
+                Trace(ManagedTraceEventType.Exception, 0, eventData.TimeStamp, TimeSpan.Zero, GetPayloadString(eventData, "ExceptionType"));
+                break;
+
+            case ThreadPoolWorkerThreadStartId or ThreadPoolWorkerThreadStopId when GetPayload<uint>(eventData, "ActiveWorkerThreadCount") is { } activeWorkers:
+                Trace(ManagedTraceEventType.ThreadPoolWorkers, (int)activeWorkers, eventData.TimeStamp, TimeSpan.Zero);
+                break;
+
+            case ThreadPoolWorkerThreadAdjustmentId when GetPayload<uint>(eventData, "NewWorkerThreadCount") is { } newWorkers:
+                Trace(ManagedTraceEventType.ThreadPoolWorkers, (int)newWorkers, eventData.TimeStamp, TimeSpan.Zero);
+                break;
+        }
+    }
+
+    private static void Trace(ManagedTraceEventType type, int value, DateTime timestamp, TimeSpan duration, string? name = null)
+    {
+        name ??= string.Empty;
+
+        fixed (char* namePtr = name)
+        {
+            var traceEvent = new ManagedTraceEvent
+            {
+                Type = type,
+                Value = value,
+                SecondsAgo = Math.Max(0.0, (DateTime.UtcNow - timestamp.ToUniversalTime()).TotalSeconds),
+                DurationSeconds = Math.Max(0.0, duration.TotalSeconds),
+                Name = namePtr,
+                NameLength = name.Length
+            };
+
+            Core.NativeDelegates.TraceEvent(&traceEvent);
+        }
+    }
+
+    // Constrained to value types, so missing payload is null rather than default value that would pass `is { }` checks
+    private static T? GetPayload<T>(EventWrittenEventArgs eventData, string name) where T : struct
+        => GetPayloadObject(eventData, name) is T value ? value : null;
+
+    private static string? GetPayloadString(EventWrittenEventArgs eventData, string name)
+        => GetPayloadObject(eventData, name) as string;
+
+    private static object? GetPayloadObject(EventWrittenEventArgs eventData, string name)
+    {
+        var index = eventData.PayloadNames?.IndexOf(name) ?? -1;
+
+        return index >= 0 ? eventData.Payload?[index] : null;
+    }
+}
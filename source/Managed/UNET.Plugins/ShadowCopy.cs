@@ -0,0 +1,158 @@
+﻿using System.Diagnostics;
+
+using UNET.Interop;
+
+namespace UNET.Plugins;
+
+/// <summary>
+/// Copy of plugin files in temporary directory, so plugin is loaded from files without locking the ones rebuilt for hot reload
+/// </summary>
+/// <remarks>
+/// Each copy gets its own versioned directory, because files of previous copy stay mapped until its context is collected.
+/// Directories that could not be deleted are removed by the next process.
+/// </remarks>
+internal sealed class ShadowCopy : IDisposable
+{
+    private static readonly string RootDirectory = Path.Combine(Path.GetTempPath(), "UNET", "ShadowCopies");
+
+    private static readonly string ProcessDirectory = Path.Combine(RootDirectory, Environment.ProcessId.ToString());
+
+    // Native libraries of dependencies are resolved from runtimes subdirectory next to plugin
+    private const string RuntimesDirectory = "runtimes";
+
+    private static int _version;
+
+    private static bool _isCleanedUp;
+
+    private ShadowCopy(string directory, string pluginPath, long imageBytes)
+    {
+        Directory = directory;
+        PluginPath = pluginPath;
+        ImageBytes = imageBytes;
+    }
+
+    public string Directory { get; }
+
+    /// <summary>
+    /// Path to copied <c>.unetplugin</c> file
+    /// </summary>
+    public string PluginPath { get; }
+
+    /// <summary>
+    /// Size of copied assembly images, symbols are copied too but not counted
+    /// </summary>
+    public long ImageBytes { get; }
+
+    /// <summary>
+    /// Copies files of plugin directory, subdirectories with other plugins are not copied
+    /// </summary>
+    /// <param name="pluginPath">Path to <c>.unetplugin</c> file</param>
+    /// <exception cref="IOException">Files can't be copied</exception>
+    /// <exception cref="UnauthorizedAccessException">Temporary directory is not writable</exception>
+    public static ShadowCopy Create(string pluginPath)
+    {
+        if (!_isCleanedUp)
+        {
+            DeleteStaleCopies();
+            _isCleanedUp = true;
+        }
+
+        var sourceDirectory = Path.GetDirectoryName(pluginPath)!;
+        var directory = Path.Combine(ProcessDirectory, $"{Path.GetFileNameWithoutExtension(pluginPath)}.{Interlocked.Increment(ref _version)}");
+
+        var imageBytes = CopyFiles(sourceDirectory, directory);
+        var runtimesDirectory = Path.Combine(sourceDirectory, RuntimesDirectory);
+
+        if (System.IO.Directory.Exists(runtimesDirectory))
+        {
+            foreach (var subdirectory in System.IO.Directory.EnumerateDirectories(runtimesDirectory, "*", SearchOption.AllDirectories).Prepend(runtimesDirectory))
+            {
+                imageBytes += CopyFiles(subdirectory, Path.Combine(directory, Path.GetRelativePath(sourceDirectory, subdirectory)));
+            }
+        }
+
+        return new ShadowCopy(directory, Path.Combine(directory, Path.GetFileName(pluginPath)), imageBytes);
+    }
+
+    private static long CopyFiles(string sourceDirectory, string targetDirectory)
+    {
+        System.IO.Directory.CreateDirectory(targetDirectory);
+
+        var imageBytes = 0L;
+
+        foreach (var file in System.IO.Directory.EnumerateFiles(sourceDirectory))
+        {
+            var target = Path.Combine(targetDirectory, Path.GetFileName(file));
+            File.Copy(file, target, overwrite: true);
+
+            if (IsImage(file))
+            {
+                imageBytes += new FileInfo(target).Length;
+            }
+        }
+
+        return imageBytes;
+    }
+
+    private static bool IsImage(string path)
+    {
+        var extension = Path.GetExtension(path);
+
+        return extension.Equals(".dll", StringComparison.OrdinalIgnoreCase) ||
+            extension.Equals(".unetplugin", StringComparison.OrdinalIgnoreCase);
+    }
+
+    // Copies of crashed or killed processes are never deleted by them
+    private static void DeleteStaleCopies()
+    {
+        if (!System.IO.Directory.Exists(RootDirectory))
+        {
+            return;
+        }
+
+        foreach (var directory in System.IO.Directory.EnumerateDirectories(RootDirectory))
+        {
+            if (int.TryParse(Path.GetFileName(directory), out var processId) && !IsRunning(processId))
+            {
+                TryDelete(directory);
+            }
+        }
+    }
+
+    private static bool IsRunning(int processId)
+    {
+        try
+        {
+            using var process = Process.GetProcessById(processId);
+            return !process.HasExited;
+        }
+        catch (ArgumentException)
+        {
+            return false;
+        }
+    }
+
+    private static bool TryDelete(string directory)
+    {
+        try
+        {
+            System.IO.Directory.Delete(directory, recursive: true);
+            return true;
+        }
+        catch (Exception exception) when (exception is IOException or UnauthorizedAccessException)
+        {
+            return false;
+        }
+    }
+
+    /// <summary>
+    /// Deletes copy, files still mapped by not yet collected context are left for the next process
+    /// </summary>
+    public void Dispose()
+    {
+        if (!TryDelete(Directory))
+        {
+            Debug.Log(ELogVerbosity.Verbose, $"Shadow copy {Directory} is still in use and will be deleted later");
+        }
+    }
+}
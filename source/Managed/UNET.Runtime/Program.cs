@@ -0,0 +1,10 @@
+﻿namespace UNET.Runtime;
+
+/// <summary>
+/// Self-contained publish requires an application, so runtime is packaged as one. It is never started
+/// </summary>
+internal static class Program
+{
+    private static void Main()
+    { }
+}
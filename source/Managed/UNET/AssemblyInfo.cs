@@ -1 +1,6 @@
-﻿[assembly: CLSCompliant(true)]
\ No newline at end of file
+﻿using System.Runtime.CompilerServices;
+
+[assembly: CLSCompliant(true)]
+
+// UNET.Plugins hosts UNET and needs direct access to native functions
+[assembly: InternalsVisibleTo("UNET.Plugins")]
\ No newline at end of file
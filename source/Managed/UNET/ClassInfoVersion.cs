@@ -0,0 +1,29 @@
+﻿namespace UNET;
+
+/// <summary>
+/// Layout version of <c>FManagedClassInfo</c> structs, values must match <c>EManagedClassInfoVersion</c> on native side
+/// </summary>
+/// <remarks>
+/// Fields are only appended to the struct, so native side reads fields of newer versions only when provider declares them
+/// </remarks>
+public enum ClassInfoVersion
+{
+    Initial,
+
+    /// <summary>
+    /// Adds <c>DefaultValues</c>
+    /// </summary>
+    DefaultValues,
+
+    /// <summary>
+    /// Adds <c>ReplicationParams</c>
+    /// </summary>
+    ReplicationParams,
+
+    /// <summary>
+    /// Adds <c>DirtyMaskOffset</c>
+    /// </summary>
+    DirtyMask,
+
+    Latest = DirtyMask,
+}
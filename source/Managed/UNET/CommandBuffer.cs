@@ -0,0 +1,428 @@
+﻿using System.Collections.Concurrent;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+using UNET.Interop;
+
+namespace UNET;
+
+/// <summary>
+/// Records engine operations into native memory and executes all of them with a single native call
+/// </summary>
+/// <remarks>
+/// Commands are executed on game thread in the order they were recorded, when buffer is submitted.
+/// Buffers can be filled on any thread, for example one per <see cref="EngineParallel"/> batch,
+/// but a single buffer must not be used by several threads at once.
+/// Recording doesn't call native code, objects are recorded as pointers and must be alive until buffer is submitted.
+/// Submit replaces all of them by weak references at once, so commands of objects destroyed by earlier commands are skipped.
+/// Layout of commands must match <c>UNET::FManagedCommandHeader</c> and payloads in <c>UNETCommandBuffer.h</c>.
+/// </remarks>
+/// <example>
+/// <code>
+/// using var commands = CommandBuffer.Rent();
+///
+/// foreach (var enemy in ObjectQuery.Query(enemyClass, ref _enemies))
+/// {
+///     commands.CallFunction(SetActorHiddenInGameStub, enemy).Set(0, true);
+/// }
+///
+/// commands.Submit();
+/// </code>
+/// </example>
+public sealed unsafe class CommandBuffer : IDisposable
+{
+    private const int CommandAlignment = 8;
+
+    // Parameters of functions are aligned relative to buffer, so its own alignment is the biggest one supported
+    private const int BufferAlignment = 16;
+
+    private const int InitialCapacity = 4096;
+    private const int InitialObjectsCapacity = 256;
+    private const int MaxPooledBuffers = 16;
+    private const int MaxPooledCapacity = 1024 * 1024;
+
+    private static readonly ConcurrentBag<CommandBuffer> _pool = new();
+
+    private byte* _buffer;
+    private int _capacity;
+
+    // Offsets of recorded object pointers in buffer, native code converts them to weak references on submit
+    private int[] _objectOffsets = Array.Empty<int>();
+    private int _objectCount;
+
+    // Set when buffer is returned to pool or freed, so repeated Dispose doesn't pool it twice
+    private bool _isDisposed;
+
+    private CommandBuffer()
+    { }
+
+    /// <summary>
+    /// Size of recorded commands in bytes
+    /// </summary>
+    public int Length { get; private set; }
+
+    /// <summary>
+    /// Count of recorded commands
+    /// </summary>
+    public int Count { get; private set; }
+
+    /// <summary>
+    /// Count of recorded <see cref="SpawnActor"/> commands, results of submit need to be at least as long
+    /// </summary>
+    public int ResultCount { get; private set; }
+
+    /// <summary>
+    /// Takes empty buffer from pool, buffer is returned to pool by <see cref="Dispose"/>
+    /// </summary>
+    public static CommandBuffer Rent()
+    {
+        if (!_pool.TryTake(out var buffer))
+        {
+            return new CommandBuffer();
+        }
+
+        buffer._isDisposed = false;
+        return buffer;
+    }
+
+    /// <summary>
+    /// Writes message to <c>LogUNETManaged</c>
+    /// </summary>
+    public void Log(ELogVerbosity level, string? message)
+    {
+        if (string.IsNullOrWhiteSpace(message))
+        {
+            return;
+        }
+
+        var command = Record<LogCommand>(CommandType.Log, message.Length * sizeof(char));
+        command->Verbosity = (int)level;
+        command->Length = message.Length;
+
+        message.AsSpan().CopyTo(new Span<char>(command + 1, message.Length));
+    }
+
+    /// <summary>
+    /// Records call of function and returns zeroed parameters frame
+    /// </summary>
+    /// <remarks>
+    /// Frame must be filled before the next command is recorded, because buffer can be moved when it grows.
+    /// Values written by function, including return value, are not available after submit.
+    /// </remarks>
+    /// <param name="stub">Function to call</param>
+    /// <param name="target">Pointer to UObject of class that declares function or its subclass</param>
+    public FunctionFrame CallFunction(FunctionStub stub, nint target)
+    {
+        if (stub is null)
+        {
+            throw new ArgumentNullException(nameof(stub));
+        }
+
+        if (target == 0)
+        {
+            throw new ArgumentNullException(nameof(target));
+        }
+
+        if (stub.ParamsAlignment > BufferAlignment)
+        {
+            throw new NotSupportedException($"Parameters aligned to {stub.ParamsAlignment} bytes can't be recorded");
+        }
+
+        // Command starts aligned to CommandAlignment, so frame alignment is applied to its offset in buffer
+        var paramsStart = Align(Length + sizeof(CommandHeader) + sizeof(CallFunctionCommand), stub.ParamsAlignment);
+        var paramsOffset = paramsStart - Length;
+
+        var command = Record<CallFunctionCommand>(CommandType.CallFunction, paramsOffset + stub.ParamsSize - sizeof(CommandHeader) - sizeof(CallFunctionCommand));
+        RecordObject(&command->Target, target);
+        RecordObject(&command->Function, stub.Function);
+        command->ParamsOffset = paramsOffset;
+        command->ParamsSize = stub.ParamsSize;
+
+        var parameters = new Span<byte>((byte*)command - sizeof(CommandHeader) + paramsOffset, stub.ParamsSize);
+        parameters.Clear();
+
+        return new FunctionFrame(stub, parameters);
+    }
+
+    /// <summary>
+    /// Records bitwise write of <paramref name="value"/> to property of <paramref name="target"/>
+    /// </summary>
+    /// <param name="target">Pointer to UObject</param>
+    /// <param name="offset">Offset of property in object</param>
+    /// <param name="value">Plain old data value of property</param>
+    /// <param name="replicatedProperty">Handle of push based property, so it is marked dirty after write</param>
+    public void SetProperty<T>(nint target, int offset, T value, ReplicatedProperty? replicatedProperty = null) where T : unmanaged
+    {
+        if (target == 0)
+        {
+            throw new ArgumentNullException(nameof(target));
+        }
+
+        var command = Record<SetPropertyCommand>(CommandType.SetProperty, sizeof(T));
+        RecordObject(&command->Target, target);
+        command->Offset = offset;
+        command->Size = sizeof(T);
+        command->RepIndex = replicatedProperty?.RepIndex ?? -1;
+
+        Unsafe.WriteUnaligned(command + 1, value);
+    }
+
+    /// <summary>
+    /// Records notification of replication about change of push based property
+    /// </summary>
+    /// <param name="target">Pointer to UObject</param>
+    /// <param name="replicatedProperty">Handle of push based property</param>
+    public void MarkPropertyDirty(nint target, ReplicatedProperty replicatedProperty)
+    {
+        if (target == 0)
+        {
+            throw new ArgumentNullException(nameof(target));
+        }
+
+        if (replicatedProperty is null)
+        {
+            throw new ArgumentNullException(nameof(replicatedProperty));
+        }
+
+        var command = Record<MarkPropertyDirtyCommand>(CommandType.MarkPropertyDirty);
+        RecordObject(&command->Target, target);
+        command->RepIndex = replicatedProperty.RepIndex;
+    }
+
+    /// <summary>
+    /// Records spawn of actor
+    /// </summary>
+    /// <param name="worldContext">Pointer to UObject which world is used to spawn actor</param>
+    /// <param name="actorClass">Pointer to UClass of actor</param>
+    /// <returns>Index in results of <see cref="Submit(Span{nint})"/>, that receives spawned actor or 0 when spawn fails</returns>
+    public int SpawnActor(nint worldContext, nint actorClass, double x, double y, double z, double pitch = 0, double yaw = 0, double roll = 0)
+    {
+        if (actorClass == 0)
+        {
+            throw new ArgumentNullException(nameof(actorClass));
+        }
+
+        var command = Record<SpawnActorCommand>(CommandType.SpawnActor);
+        RecordObject(&command->WorldContext, worldContext);
+        RecordObject(&command->Class, actorClass);
+        command->X = x;
+        command->Y = y;
+        command->Z = z;
+        command->Pitch = pitch;
+        command->Yaw = yaw;
+        command->Roll = roll;
+        command->ResultIndex = ResultCount;
+
+        return ResultCount++;
+    }
+
+    /// <summary>
+    /// Records destruction of actor
+    /// </summary>
+    /// <param name="actor">Pointer to AActor</param>
+    public void DestroyActor(nint actor)
+    {
+        if (actor == 0)
+        {
+            throw new ArgumentNullException(nameof(actor));
+        }
+
+        var command = Record<DestroyActorCommand>(CommandType.DestroyActor);
+        RecordObject(&command->Target, actor);
+    }
+
+    /// <summary>
+    /// Executes recorded commands on game thread and clears buffer
+    /// </summary>
+    /// <returns>Count of executed commands, commands of invalid objects are skipped</returns>
+    /// <exception cref="InvalidOperationException">Thrown when called outside of game thread, commands are kept</exception>
+    public int Submit() => Submit(Span<nint>.Empty);
+
+    /// <inheritdoc cref="Submit()"/>
+    /// <param name="results">Receives actors spawned by <see cref="SpawnActor"/> at indices it returned</param>
+    public int Submit(Span<nint> results)
+    {
+        if (Count == 0)
+        {
+            return 0;
+        }
+
+        results.Clear();
+
+        int executed;
+
+        fixed (int* objectOffsetsPtr = _objectOffsets)
+        fixed (nint* resultsPtr = results)
+        {
+            executed = Core.NativeDelegates.ExecuteCommands(_buffer, Length, objectOffsetsPtr, _objectCount, resultsPtr, results.Length);
+        }
+
+        if (executed < 0)
+        {
+            throw new InvalidOperationException("Command buffer can only be submitted on game thread");
+        }
+
+        Clear();
+        return executed;
+    }
+
+    /// <summary>
+    /// Discards recorded commands
+    /// </summary>
+    public void Clear()
+    {
+        Length = 0;
+        Count = 0;
+        ResultCount = 0;
+        _objectCount = 0;
+    }
+
+    /// <summary>
+    /// Discards recorded commands and returns buffer to pool, it must not be used after that
+    /// </summary>
+    public void Dispose()
+    {
+        if (_isDisposed)
+        {
+            return;
+        }
+
+        _isDisposed = true;
+
+        Clear();
+
+        // Buffers grown by unusually big batches are not kept, so pool doesn't hold their memory forever
+        if (_capacity > MaxPooledCapacity || _pool.Count >= MaxPooledBuffers)
+        {
+            EngineMemory.Free(_buffer);
+            _buffer = null;
+            _capacity = 0;
+            _objectOffsets = Array.Empty<int>();
+            return;
+        }
+
+        _pool.Add(this);
+    }
+
+    private TCommand* Record<TCommand>(CommandType type, int trailingSize = 0) where TCommand : unmanaged
+    {
+        var size = Align(sizeof(CommandHeader) + sizeof(TCommand) + trailingSize, CommandAlignment);
+
+        EnsureCapacity(Length + size);
+
+        var header = (CommandHeader*)(_buffer + Length);
+        header->Type = type;
+        header->Reserved = 0;
+        header->Size = (uint)size;
+
+        Length += size;
+        Count++;
+
+        return (TCommand*)(header + 1);
+    }
+
+    private void RecordObject(nint* field, nint obj)
+    {
+        *field = obj;
+
+        if (_objectCount == _objectOffsets.Length)
+        {
+            Array.Resize(ref _objectOffsets, Math.Max(_objectOffsets.Length * 2, InitialObjectsCapacity));
+        }
+
+        _objectOffsets[_objectCount++] = (int)((byte*)field - _buffer);
+    }
+
+    private void EnsureCapacity(int required)
+    {
+        if (required <= _capacity)
+        {
+            return;
+        }
+
+        var capacity = Math.Max(Math.Max(_capacity * 2, InitialCapacity), required);
+
+        _buffer = (byte*)EngineMemory.Realloc(_buffer, (nuint)capacity, BufferAlignment);
+        _capacity = capacity;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int Align(int value, int alignment) => (value + alignment - 1) & ~(alignment - 1);
+
+    /// <summary>
+    /// Must match <c>UNET::EManagedCommand</c>
+    /// </summary>
+    private enum CommandType : ushort
+    {
+        Log,
+        CallFunction,
+        SetProperty,
+        MarkPropertyDirty,
+        SpawnActor,
+        DestroyActor
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct CommandHeader
+    {
+        public CommandType Type;
+        public ushort Reserved;
+        public uint Size;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct LogCommand
+    {
+        public int Verbosity;
+        public int Length;
+    }
+
+    // Object fields hold pointers until submit, native code replaces them by UNET::FManagedObjectRef of the same size
+    [StructLayout(LayoutKind.Sequential)]
+    private struct CallFunctionCommand
+    {
+        public nint Target;
+        public nint Function;
+        public int ParamsOffset;
+        public int ParamsSize;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct SetPropertyCommand
+    {
+        public nint Target;
+        public int Offset;
+        public int Size;
+        public int RepIndex;
+        public int Reserved;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct MarkPropertyDirtyCommand
+    {
+        public nint Target;
+        public int RepIndex;
+        public int Reserved;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct SpawnActorCommand
+    {
+        public nint WorldContext;
+        public nint Class;
+        public double X;
+        public double Y;
+        public double Z;
+        public double Pitch;
+        public double Yaw;
+        public double Roll;
+        public int ResultIndex;
+        public int Reserved;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct DestroyActorCommand
+    {
+        public nint Target;
+    }
+}
@@ -0,0 +1,69 @@
+﻿using System.Reflection;
+
+namespace UNET;
+
+/// <summary>
+/// Binds UE dynamic delegates to managed handlers
+/// </summary>
+/// <remarks>
+/// Handler must be a static method marked with <see cref="System.Runtime.InteropServices.UnmanagedCallersOnlyAttribute"/>.
+/// It receives <c>handle</c> passed on binding and pointer to parameters struct of delegate,
+/// so nothing is boxed or allocated when delegate is broadcast.
+/// Bindings are owned by assembly passed to <see cref="Bind"/>, usually the one that declares handler,
+/// they are removed when its plugin is reloaded and when all plugins are unloaded.
+/// </remarks>
+public static unsafe class DelegateBinding
+{
+    /// <summary>
+    /// Subscribes <paramref name="handler"/> to dynamic delegate property of <paramref name="target"/>
+    /// </summary>
+    /// <param name="owner">Assembly of plugin that declares <paramref name="handler"/>, like <c>typeof(MyActor).Assembly</c></param>
+    /// <param name="target">Pointer to UObject that owns delegate</param>
+    /// <param name="delegateName">Name of delegate property, like <c>OnActorBeginOverlap</c></param>
+    /// <param name="handler">Managed function, that is called with <paramref name="handle"/> and pointer to delegate parameters</param>
+    /// <param name="handle">Opaque value passed back to <paramref name="handler"/>, usually <see cref="System.Runtime.InteropServices.GCHandle"/> of facade</param>
+    /// <returns>Binding that can be passed to <see cref="Unbind"/></returns>
+    /// <exception cref="ArgumentException">Target doesn't have such delegate</exception>
+    [CLSCompliant(false)]
+    public static nint Bind(Assembly owner, nint target, string delegateName, delegate* unmanaged[Cdecl]<nint, void*, void> handler, nint handle)
+    {
+        if (owner is null)
+        {
+            throw new ArgumentNullException(nameof(owner));
+        }
+
+        if (target == 0)
+        {
+            throw new ArgumentNullException(nameof(target));
+        }
+
+        if (handler is null)
+        {
+            throw new ArgumentNullException(nameof(handler));
+        }
+
+        // Reload unbinds delegates by name of plugin assembly, so the same name is recorded here
+        var ownerName = owner.GetName().Name ?? string.Empty;
+        var binding = Core.NativeDelegates.BindDelegate(target, delegateName, handler, handle, ownerName);
+
+        if (binding == 0)
+        {
+            throw new ArgumentException($"Object has no dynamic delegate '{delegateName}'", nameof(delegateName));
+        }
+
+        return binding;
+    }
+
+    /// <summary>
+    /// Removes binding created by <see cref="Bind"/>
+    /// </summary>
+    public static void Unbind(nint binding)
+    {
+        if (binding == 0)
+        {
+            return;
+        }
+
+        Core.NativeDelegates.UnbindDelegate(binding);
+    }
+}
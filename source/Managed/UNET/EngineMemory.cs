@@ -0,0 +1,75 @@
+﻿namespace UNET;
+
+/// <summary>
+/// Allocates native memory with Unreal Engine allocator
+/// </summary>
+/// <remarks>
+/// Unlike <see cref="System.Runtime.InteropServices.NativeMemory"/>, memory allocated here is served by FMalloc
+/// and tracked by LLM under <c>UNET_Interop</c> tag, so buffers shared with engine should be allocated here.
+/// </remarks>
+[CLSCompliant(false)]
+public static unsafe class EngineMemory
+{
+    /// <summary>
+    /// Alignment chosen by FMalloc, at least 8 or 16 bytes depending on size of allocation
+    /// </summary>
+    public const uint DefaultAlignment = 0;
+
+    /// <summary>
+    /// Allocates block of memory, that must be released with <see cref="Free"/>
+    /// </summary>
+    /// <param name="size">Size of block in bytes</param>
+    /// <param name="alignment">Power of two alignment of block</param>
+    public static void* Alloc(nuint size, uint alignment = DefaultAlignment)
+        => Core.NativeDelegates.Malloc(size, alignment);
+
+    /// <summary>
+    /// Allocates block for <paramref name="count"/> elements of <typeparamref name="T"/>, that must be released with <see cref="Free"/>
+    /// </summary>
+    public static T* Alloc<T>(int count) where T : unmanaged
+        => (T*)Alloc(GetSize<T>(count));
+
+    /// <summary>
+    /// Resizes block allocated by <see cref="Alloc"/>, content is kept up to the smallest of sizes
+    /// </summary>
+    /// <param name="original">Block to resize, can be null</param>
+    /// <param name="size">New size of block in bytes</param>
+    /// <param name="alignment">Alignment used to allocate <paramref name="original"/></param>
+    public static void* Realloc(void* original, nuint size, uint alignment = DefaultAlignment)
+        => Core.NativeDelegates.Realloc(original, size, alignment);
+
+    /// <summary>
+    /// Releases block allocated by <see cref="Alloc"/> or <see cref="Realloc"/>
+    /// </summary>
+    public static void Free(void* original)
+        => Core.NativeDelegates.Free(original);
+
+    /// <summary>
+    /// Allocates scratch block from frame arena, it doesn't need to be released
+    /// </summary>
+    /// <remarks>
+    /// All frame allocations are reset at once on game thread at the end of frame, so block must not be used after it.
+    /// Arena is not synchronized and can be used only on game thread, other threads should use <see cref="Alloc(nuint, uint)"/>.
+    /// </remarks>
+    /// <param name="size">Size of block in bytes</param>
+    /// <param name="alignment">Power of two alignment of block</param>
+    public static void* AllocFrame(nuint size, uint alignment = DefaultAlignment)
+        => Core.NativeDelegates.FrameAlloc(size, alignment);
+
+    /// <summary>
+    /// Allocates scratch buffer for <paramref name="count"/> elements of <typeparamref name="T"/> from frame arena
+    /// </summary>
+    /// <inheritdoc cref="AllocFrame(nuint, uint)"/>
+    public static Span<T> AllocFrame<T>(int count) where T : unmanaged
+        => new(AllocFrame(GetSize<T>(count)), count);
+
+    private static nuint GetSize<T>(int count) where T : unmanaged
+    {
+        if (count < 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(count));
+        }
+
+        return checked((nuint)count * (nuint)sizeof(T));
+    }
+}
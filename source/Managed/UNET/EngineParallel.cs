@@ -0,0 +1,126 @@
+﻿using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace UNET;
+
+/// <summary>
+/// Parallel loops executed by Unreal Engine task graph workers
+/// </summary>
+/// <remarks>
+/// Unlike <see cref="Parallel"/>, work is done on engine threads, so managed and native code don't compete for cores.
+/// Elements are split into batches and managed code is entered once per batch.
+/// </remarks>
+public static unsafe class EngineParallel
+{
+    /// <summary>
+    /// Minimal count of elements processed by single call of body
+    /// </summary>
+    public const int DefaultMinBatchSize = 64;
+
+    private sealed class LoopContext
+    {
+        public LoopContext(Action<int, int> body)
+        {
+            Body = body;
+        }
+
+        public Action<int, int> Body { get; }
+
+        public List<Exception>? Exceptions { get; private set; }
+
+        public bool IsFaulted => Volatile.Read(ref _isFaulted);
+
+        private bool _isFaulted;
+
+        public void AddException(Exception exception)
+        {
+            lock (this)
+            {
+                (Exceptions ??= new()).Add(exception);
+                Volatile.Write(ref _isFaulted, true);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Executes <paramref name="body"/> for each index from <paramref name="fromInclusive"/> to <paramref name="toExclusive"/>
+    /// and returns when all of them are processed
+    /// </summary>
+    /// <exception cref="AggregateException">Thrown when body has thrown exception, batches that weren't started are skipped</exception>
+    public static void For(int fromInclusive, int toExclusive, Action<int> body, int minBatchSize = DefaultMinBatchSize)
+    {
+        if (body is null)
+        {
+            throw new ArgumentNullException(nameof(body));
+        }
+
+        ForBatched(toExclusive - fromInclusive, (start, end) =>
+        {
+            for (var i = start; i < end; i++)
+            {
+                body(fromInclusive + i);
+            }
+        }, minBatchSize);
+    }
+
+    /// <summary>
+    /// Executes <paramref name="body"/> for batches of range from 0 to <paramref name="count"/>
+    /// and returns when all of them are processed
+    /// </summary>
+    /// <param name="count">Count of elements</param>
+    /// <param name="body">Processes elements from start index up to end index</param>
+    /// <param name="minBatchSize">Minimal count of elements in one batch</param>
+    /// <inheritdoc cref="For(int, int, Action{int}, int)"/>
+    public static void ForBatched(int count, Action<int, int> body, int minBatchSize = DefaultMinBatchSize)
+    {
+        if (body is null)
+        {
+            throw new ArgumentNullException(nameof(body));
+        }
+
+        if (count <= 0)
+        {
+            return;
+        }
+
+        var context = new LoopContext(body);
+        var handle = GCHandle.Alloc(context);
+
+        try
+        {
+            Core.NativeDelegates.ParallelFor(count, minBatchSize, &RunBatch, GCHandle.ToIntPtr(handle));
+        }
+        finally
+        {
+            handle.Free();
+        }
+
+        if (context.Exceptions is not null)
+        {
+            throw new AggregateException(context.Exceptions);
+        }
+    }
+
+#pragma warning disable CS3016 // Arrays as attribute arguments is not CLS-compliant
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void RunBatch(nint contextHandle, int start, int end)
+    {
+        var context = (LoopContext)GCHandle.FromIntPtr(contextHandle).Target!;
+
+        if (context.IsFaulted)
+        {
+            return;
+        }
+
+        // Exception can't cross native frames, so it is rethrown by caller of the loop
+        try
+        {
+            context.Body(start, end);
+        }
+        catch (Exception exception)
+        {
+            context.AddException(exception);
+        }
+    }
+#pragma warning restore CS3016 // Arrays as attribute arguments is not CLS-compliant
+}
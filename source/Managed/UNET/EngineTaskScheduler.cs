@@ -0,0 +1,62 @@
+﻿using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace UNET;
+
+/// <summary>
+/// Schedules tasks on Unreal Engine task graph workers instead of .NET thread pool
+/// </summary>
+/// <example>
+/// <code>
+/// var result = await EngineTaskScheduler.Factory.StartNew(() => BuildNavigationData(level));
+/// </code>
+/// </example>
+public sealed unsafe class EngineTaskScheduler : TaskScheduler
+{
+    private EngineTaskScheduler()
+    { }
+
+    public static EngineTaskScheduler Instance { get; } = new();
+
+    /// <summary>
+    /// Starts tasks with <see cref="Instance"/>, <see cref="Task.Run(Action)"/> always uses .NET thread pool
+    /// </summary>
+    public static TaskFactory Factory { get; } = new(Instance);
+
+    [ThreadStatic]
+    private static bool _isExecutingTask;
+
+    protected override void QueueTask(Task task)
+    {
+        var handle = GCHandle.Alloc(task);
+        Core.NativeDelegates.LaunchTask(&ExecuteTask, GCHandle.ToIntPtr(handle));
+    }
+
+    // Continuations can run inline only on engine workers, so they never land on game thread unexpectedly
+    protected override bool TryExecuteTaskInline(Task task, bool taskWasPreviouslyQueued)
+        => _isExecutingTask && TryExecuteTask(task);
+
+    // Queue is owned by engine, so tasks can't be listed for debugger
+    protected override IEnumerable<Task>? GetScheduledTasks() => null;
+
+#pragma warning disable CS3016 // Arrays as attribute arguments is not CLS-compliant
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static void ExecuteTask(nint taskHandle)
+    {
+        var handle = GCHandle.FromIntPtr(taskHandle);
+        var task = (Task)handle.Target!;
+        handle.Free();
+
+        _isExecutingTask = true;
+
+        try
+        {
+            Instance.TryExecuteTask(task);
+        }
+        finally
+        {
+            _isExecutingTask = false;
+        }
+    }
+#pragma warning restore CS3016 // Arrays as attribute arguments is not CLS-compliant
+}
@@ -0,0 +1,189 @@
+﻿using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace UNET;
+
+/// <summary>
+/// Layout of UFunction parameters, must match <c>UNET::FManagedFunctionInfo</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct FunctionInfo
+{
+    public nint Function;
+    public int ParamsSize;
+    public int ParamsAlignment;
+    public int ReturnValueOffset;
+    public int NumParams;
+}
+
+/// <summary>
+/// Call stub of native UFunction, resolved once and reused for all calls
+/// </summary>
+/// <remarks>
+/// Stubs are declared manually in static fields and resolved with <see cref="Resolve"/>,
+/// so calls don't look up function by name and don't allocate.
+/// Only functions with plain old data parameters are supported.
+/// </remarks>
+/// <example>
+/// <code>
+/// private static readonly FunctionStub SetActorHiddenInGameStub = FunctionStub.Resolve("Actor", "SetActorHiddenInGame");
+///
+/// public void SetActorHiddenInGame(bool newHidden)
+/// {
+///     var frame = SetActorHiddenInGameStub.CreateFrame(stackalloc byte[SetActorHiddenInGameStub.FrameBufferSize]);
+///     frame.Set(0, newHidden);
+///     frame.Invoke(NativePointer);
+/// }
+/// </code>
+/// </example>
+public sealed class FunctionStub
+{
+    private const int InlineParamsCapacity = 32;
+
+    private readonly int[] _paramOffsets;
+
+    private FunctionStub(FunctionInfo info, int[] paramOffsets)
+    {
+        Function = info.Function;
+        ParamsSize = info.ParamsSize;
+        ParamsAlignment = Math.Max(info.ParamsAlignment, 1);
+        ReturnValueOffset = info.ReturnValueOffset;
+
+        _paramOffsets = paramOffsets;
+    }
+
+    /// <summary>
+    /// Pointer to UFunction
+    /// </summary>
+    public nint Function { get; }
+
+    /// <summary>
+    /// Size of parameters frame
+    /// </summary>
+    public int ParamsSize { get; }
+
+    public int ParamsAlignment { get; }
+
+    /// <summary>
+    /// Offset of return value in parameters frame, or -1 when function returns nothing
+    /// </summary>
+    public int ReturnValueOffset { get; }
+
+    /// <summary>
+    /// Count of parameters without return value
+    /// </summary>
+    public int ParamsCount => _paramOffsets.Length;
+
+    /// <summary>
+    /// Size of buffer that fits aligned parameters frame
+    /// </summary>
+    public int FrameBufferSize => ParamsSize + ParamsAlignment - 1;
+
+    /// <summary>
+    /// Resolves function and layout of its parameters
+    /// </summary>
+    /// <param name="className">Name of UClass without prefix, like <c>Actor</c></param>
+    /// <param name="functionName">Name of UFunction</param>
+    /// <exception cref="MissingMethodException">Function is not found or has parameters that can't be passed bitwise</exception>
+    public static unsafe FunctionStub Resolve(string className, string functionName)
+    {
+        FunctionInfo info;
+        Span<int> paramOffsets = stackalloc int[InlineParamsCapacity];
+
+        if (!Core.NativeDelegates.ResolveFunction(className, functionName, &info, paramOffsets))
+        {
+            throw new MissingMethodException(className, functionName);
+        }
+
+        if (info.NumParams > paramOffsets.Length)
+        {
+            paramOffsets = new int[info.NumParams];
+            Core.NativeDelegates.ResolveFunction(className, functionName, &info, paramOffsets);
+        }
+
+        return new FunctionStub(info, paramOffsets[..info.NumParams].ToArray());
+    }
+
+    /// <summary>
+    /// Creates zeroed parameters frame in <paramref name="buffer"/>, that is usually allocated with <c>stackalloc</c>
+    /// </summary>
+    /// <param name="buffer">Memory of at least <see cref="FrameBufferSize"/> bytes, that is not moved by GC until call</param>
+    public unsafe FunctionFrame CreateFrame(Span<byte> buffer)
+    {
+        if (buffer.Length < FrameBufferSize)
+        {
+            throw new ArgumentException($"Buffer must be at least {FrameBufferSize} bytes long", nameof(buffer));
+        }
+
+        // Alignment is applied to address, so buffer has to be on stack or pinned
+        var address = (nint)Unsafe.AsPointer(ref MemoryMarshal.GetReference(buffer));
+        var padding = (int)(((address + ParamsAlignment - 1) & ~(nint)(ParamsAlignment - 1)) - address);
+
+        var frame = buffer.Slice(padding, ParamsSize);
+        frame.Clear();
+
+        return new FunctionFrame(this, frame);
+    }
+
+    internal int GetParamOffset(int index) => _paramOffsets[index];
+}
+
+/// <summary>
+/// Parameters of single call of <see cref="FunctionStub"/>
+/// </summary>
+public readonly ref struct FunctionFrame
+{
+    private readonly FunctionStub _stub;
+    private readonly Span<byte> _params;
+
+    internal FunctionFrame(FunctionStub stub, Span<byte> parameters)
+    {
+        _stub = stub;
+        _params = parameters;
+    }
+
+    /// <summary>
+    /// Writes value of parameter
+    /// </summary>
+    /// <param name="index">Index of parameter in function signature, return value is not counted</param>
+    public void Set<T>(int index, T value) where T : unmanaged
+        => MemoryMarshal.Write(_params[_stub.GetParamOffset(index)..], ref value);
+
+    /// <summary>
+    /// Reads value of parameter, that is useful for parameters passed by reference
+    /// </summary>
+    /// <inheritdoc cref="Set"/>
+    public T Get<T>(int index) where T : unmanaged
+        => MemoryMarshal.Read<T>(_params[_stub.GetParamOffset(index)..]);
+
+    /// <summary>
+    /// Reads return value after <see cref="Invoke"/>
+    /// </summary>
+    public T GetReturnValue<T>() where T : unmanaged
+    {
+        if (_stub.ReturnValueOffset < 0)
+        {
+            throw new InvalidOperationException("Function doesn't return a value");
+        }
+
+        return MemoryMarshal.Read<T>(_params[_stub.ReturnValueOffset..]);
+    }
+
+    /// <summary>
+    /// Calls function on <paramref name="target"/> with a single native call.
+    /// Native functions without networking or blueprint overrides are called via their thunk, others via ProcessEvent.
+    /// </summary>
+    /// <param name="target">Pointer to UObject of class that declares function or its subclass</param>
+    public unsafe void Invoke(nint target)
+    {
+        if (target == 0)
+        {
+            throw new ArgumentNullException(nameof(target));
+        }
+
+        fixed (byte* paramsPtr = _params)
+        {
+            Core.NativeDelegates.CallFunction(target, _stub.Function, paramsPtr);
+        }
+    }
+}
@@ -3,4 +3,16 @@
 public interface IMetadataProvider
 {
     public IEnumerable<nint> Classes { get; }
+
+    /// <summary>
+    /// Layout version of class infos in <see cref="Classes"/>, providers of generators that predate versioning don't override it
+    /// </summary>
+    public ClassInfoVersion ClassInfoVersion => ClassInfoVersion.Initial;
+
+    /// <summary>
+    /// Called instead of reading <see cref="Classes"/>, when classes were registered from precompiled metadata of plugin
+    /// </summary>
+    /// <param name="propertiesOffsets">Offset of the first own property of each class, in the same order as classes in metadata</param>
+    public void OnMetadataRegistered(ReadOnlySpan<int> propertiesOffsets)
+    { }
 }
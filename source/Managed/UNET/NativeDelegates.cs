@@ -8,7 +8,27 @@ internal unsafe struct NativeDelegates
     private readonly delegate* unmanaged[Cdecl]<ELogVerbosity, nint, int, void> _log;
     private readonly delegate* unmanaged[Cdecl]<nint, nint> _outerRegisterInternal;
     private readonly delegate* unmanaged[Cdecl]<nint, nint> _innerRegisterInternal;
-    private readonly delegate* unmanaged[Cdecl]<nint, void> _registerManagedClass;
+    private readonly delegate* unmanaged[Cdecl]<nint, ClassInfoVersion, void> _registerManagedClass;
+    private readonly delegate* unmanaged[Cdecl]<void> _ping;
+    private readonly delegate* unmanaged[Cdecl]<char*, int, int*, int*> _registerClassMetadata;
+    private readonly delegate* unmanaged[Cdecl]<nint, char*, int, delegate* unmanaged[Cdecl]<nint, void*, void>, nint, char*, int, nint> _bindDelegate;
+    private readonly delegate* unmanaged[Cdecl]<nint, void> _unbindDelegate;
+    private readonly delegate* unmanaged[Cdecl]<nint, nint*, nint*, int, int> _queryInstances;
+    private readonly delegate* unmanaged[Cdecl]<void*, void> _traceEvent;
+    private readonly delegate* unmanaged[Cdecl]<nuint, uint, void*> _malloc;
+    private readonly delegate* unmanaged[Cdecl]<void*, nuint, uint, void*> _realloc;
+    private readonly delegate* unmanaged[Cdecl]<void*, void> _free;
+    private readonly delegate* unmanaged[Cdecl]<nuint, uint, void*> _frameAlloc;
+    private readonly delegate* unmanaged[Cdecl]<char*, int, char*, int, FunctionInfo*, int*, int, byte> _resolveFunction;
+    private readonly delegate* unmanaged[Cdecl]<nint, nint, void*, void> _callFunction;
+    private readonly delegate* unmanaged[Cdecl]<int, int, delegate* unmanaged[Cdecl]<nint, int, int, void>, nint, void> _parallelFor;
+    private readonly delegate* unmanaged[Cdecl]<delegate* unmanaged[Cdecl]<nint, void>, nint, void> _launchTask;
+    private readonly delegate* unmanaged[Cdecl]<HostInfo*, void> _getHostInfo;
+    private readonly delegate* unmanaged[Cdecl]<nint, char*, int, int> _getRepIndex;
+    private readonly delegate* unmanaged[Cdecl]<nint, int, void> _markPropertyDirty;
+    private readonly delegate* unmanaged[Cdecl]<char*, int, int, void> _registerDeferredClass;
+    private readonly delegate* unmanaged[Cdecl]<byte*, int, int*, int, nint*, int, int> _executeCommands;
+    private readonly delegate* unmanaged[Cdecl]<char*, int, void> _unbindOwnedDelegates;
 #pragma warning restore CS0649
 
     public void Log(ELogVerbosity level, nint message, int length)
@@ -20,6 +40,121 @@ internal unsafe struct NativeDelegates
     public IntPtr InnerRegisterInternal(nint infoPtr)
         => _innerRegisterInternal(infoPtr);
 
-    public void RegisterManagedClass(nint infoPtr)
-        => _registerManagedClass(infoPtr);
+    public void RegisterManagedClass(nint infoPtr, ClassInfoVersion version)
+        => _registerManagedClass(infoPtr, version);
+
+    public void Ping()
+        => _ping();
+
+    public bool RegisterClassMetadata(string path, out ReadOnlySpan<int> propertiesOffsets)
+    {
+        var numClasses = 0;
+        int* offsets;
+
+        fixed (char* pathPtr = path)
+        {
+            offsets = _registerClassMetadata(pathPtr, path.Length, &numClasses);
+        }
+
+        propertiesOffsets = offsets is null ? default : new ReadOnlySpan<int>(offsets, numClasses);
+        return offsets is not null;
+    }
+
+    public nint BindDelegate(nint target, string delegateName, delegate* unmanaged[Cdecl]<nint, void*, void> handler, nint handle, string owner)
+    {
+        fixed (char* namePtr = delegateName)
+        fixed (char* ownerPtr = owner)
+        {
+            return _bindDelegate(target, namePtr, delegateName.Length, handler, handle, ownerPtr, owner.Length);
+        }
+    }
+
+    public void UnbindDelegate(nint binding)
+        => _unbindDelegate(binding);
+
+    public int QueryInstances(nint managedClass, nint* objects, nint* propertyBases, int capacity)
+        => _queryInstances(managedClass, objects, propertyBases, capacity);
+
+    public void TraceEvent(void* traceEvent)
+        => _traceEvent(traceEvent);
+
+    public void* Malloc(nuint size, uint alignment)
+        => _malloc(size, alignment);
+
+    public void* Realloc(void* original, nuint size, uint alignment)
+        => _realloc(original, size, alignment);
+
+    public void Free(void* original)
+        => _free(original);
+
+    public void* FrameAlloc(nuint size, uint alignment)
+        => _frameAlloc(size, alignment);
+
+    public bool ResolveFunction(string className, string functionName, FunctionInfo* info, Span<int> paramOffsets)
+    {
+        fixed (char* classNamePtr = className)
+        fixed (char* functionNamePtr = functionName)
+        fixed (int* paramOffsetsPtr = paramOffsets)
+        {
+            return _resolveFunction(classNamePtr, className.Length, functionNamePtr, functionName.Length, info, paramOffsetsPtr, paramOffsets.Length) != 0;
+        }
+    }
+
+    public void CallFunction(nint target, nint function, void* parameters)
+        => _callFunction(target, function, parameters);
+
+    public void ParallelFor(int count, int minBatchSize, delegate* unmanaged[Cdecl]<nint, int, int, void> body, nint context)
+        => _parallelFor(count, minBatchSize, body, context);
+
+    public void LaunchTask(delegate* unmanaged[Cdecl]<nint, void> body, nint context)
+        => _launchTask(body, context);
+
+    public void GetHostInfo(out PluginTargets target, out string platform)
+    {
+        HostInfo info;
+        _getHostInfo(&info);
+
+        target = info.Target;
+        platform = new string(info.Platform, 0, info.PlatformLength);
+    }
+
+    public int GetRepIndex(nint managedClass, string propertyName)
+    {
+        fixed (char* namePtr = propertyName)
+        {
+            return _getRepIndex(managedClass, namePtr, propertyName.Length);
+        }
+    }
+
+    public void MarkPropertyDirty(nint target, int repIndex)
+        => _markPropertyDirty(target, repIndex);
+
+    public void RegisterDeferredClass(string className, int pluginId)
+    {
+        fixed (char* namePtr = className)
+        {
+            _registerDeferredClass(namePtr, className.Length, pluginId);
+        }
+    }
+
+    public int ExecuteCommands(byte* commands, int size, int* objectOffsets, int objectCount, nint* results, int resultsCapacity)
+        => _executeCommands(commands, size, objectOffsets, objectCount, results, resultsCapacity);
+
+    public void UnbindOwnedDelegates(string owner)
+    {
+        fixed (char* ownerPtr = owner)
+        {
+            _unbindOwnedDelegates(ownerPtr, owner.Length);
+        }
+    }
+
+    /// <summary>
+    /// Layout must match <c>UNET::FManagedHostInfo</c>
+    /// </summary>
+    private struct HostInfo
+    {
+        public PluginTargets Target;
+        public char* Platform;
+        public int PlatformLength;
+    }
 }
@@ -0,0 +1,66 @@
+﻿namespace UNET;
+
+/// <summary>
+/// Enumerates live UE objects of managed classes in a single native call
+/// </summary>
+/// <remarks>
+/// Native side keeps list of instances for each managed class, so query doesn't iterate all UObjects.
+/// Results are valid until objects are destroyed by GC, so they should be processed in the same frame.
+/// </remarks>
+public static unsafe class ObjectQuery
+{
+    /// <summary>
+    /// Fills <paramref name="objects"/> with instances of <paramref name="managedClass"/> and its subclasses
+    /// </summary>
+    /// <param name="managedClass">Pointer to UClass of managed class or blueprint derived from it</param>
+    /// <param name="objects">Receives pointers to UObjects</param>
+    /// <returns>Count of all instances, when it is bigger than length of <paramref name="objects"/> only part of them is written</returns>
+    public static int Query(nint managedClass, Span<nint> objects)
+    {
+        fixed (nint* objectsPtr = objects)
+        {
+            return Core.NativeDelegates.QueryInstances(managedClass, objectsPtr, null, objects.Length);
+        }
+    }
+
+    /// <summary>
+    /// Fills <paramref name="objects"/> with instances of <paramref name="managedClass"/> and its subclasses,
+    /// and <paramref name="propertyBases"/> with addresses of their first managed property
+    /// </summary>
+    /// <inheritdoc cref="Query(nint, Span{nint})"/>
+    /// <param name="propertyBases">Receives address of the first managed property of each object, must be at least as long as <paramref name="objects"/></param>
+    public static int Query(nint managedClass, Span<nint> objects, Span<nint> propertyBases)
+    {
+        if (propertyBases.Length < objects.Length)
+        {
+            throw new ArgumentException($"Length of {nameof(propertyBases)} is less than length of {nameof(objects)}", nameof(propertyBases));
+        }
+
+        fixed (nint* objectsPtr = objects)
+        fixed (nint* propertyBasesPtr = propertyBases)
+        {
+            return Core.NativeDelegates.QueryInstances(managedClass, objectsPtr, propertyBasesPtr, objects.Length);
+        }
+    }
+
+    /// <summary>
+    /// Returns all instances of <paramref name="managedClass"/> and its subclasses, growing <paramref name="buffer"/> when it is too small
+    /// </summary>
+    /// <param name="managedClass">Pointer to UClass of managed class or blueprint derived from it</param>
+    /// <param name="buffer">Reusable buffer, replaced by bigger one when needed</param>
+    /// <returns>Part of <paramref name="buffer"/> filled with instances</returns>
+    public static Span<nint> Query(nint managedClass, ref nint[] buffer)
+    {
+        buffer ??= Array.Empty<nint>();
+
+        var count = Query(managedClass, buffer);
+
+        if (count > buffer.Length)
+        {
+            buffer = new nint[Math.Max(count, buffer.Length * 2)];
+            count = Math.Min(Query(managedClass, buffer), buffer.Length);
+        }
+
+        return buffer.AsSpan(0, count);
+    }
+}
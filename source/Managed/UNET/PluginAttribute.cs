@@ -14,10 +14,23 @@
 public abstract class PluginAttribute : Attribute
 {
     protected PluginAttribute(IMetadataProvider metadataProvider)
+        : this(metadataProvider, PluginTargets.All)
+    { }
+
+    protected PluginAttribute(IMetadataProvider metadataProvider, PluginTargets targets)
     {
         MetadataProvider = metadataProvider;
+        Targets = targets;
     }
 
     public IMetadataProvider MetadataProvider { get; }
+
+    /// <summary>
+    /// Processes that use plugin, it is unloaded right after load in other ones
+    /// </summary>
+    /// <remarks>
+    /// Attribute can be read only from loaded assembly, so <c>.unetmanifest</c> is used to skip plugin without loading it
+    /// </remarks>
+    public PluginTargets Targets { get; }
 }
 #pragma warning restore CS3015 // Type has no accessible constructors which use only CLS-compliant types
\ No newline at end of file
@@ -28,10 +28,44 @@ public sealed class PluginManager
 
         foreach (var classInfo in metadata.Classes)
         {
-            Core.NativeDelegates.RegisterManagedClass(classInfo);
+            Core.NativeDelegates.RegisterManagedClass(classInfo, metadata.ClassInfoVersion);
         }
     }
 
+    /// <summary>
+    /// Registers classes of plugin from precompiled metadata, that is read and linked by native side
+    /// </summary>
+    /// <param name="assembly">Plugin assembly</param>
+    /// <param name="metadataPath">Path to <c>.unetmeta</c> file of plugin</param>
+    /// <returns><see langword="false"/> when metadata can't be used, nothing is registered in that case</returns>
+    public static bool Initialize(Assembly assembly, string metadataPath)
+    {
+        if (!Core.IsInitialized)
+        {
+            throw new NotInitializedException();
+        }
+
+        if (assembly is null)
+        {
+            throw new ArgumentNullException(nameof(assembly));
+        }
+
+        var attribute = assembly.GetCustomAttribute<PluginAttribute>();
+
+        if (attribute is null)
+        {
+            throw new NotSupportedException($"Assembly {assembly.GetName().Name} is not marked as Plugin");
+        }
+
+        if (!Core.NativeDelegates.RegisterClassMetadata(metadataPath, out var propertiesOffsets))
+        {
+            return false;
+        }
+
+        attribute.MetadataProvider.OnMetadataRegistered(propertiesOffsets);
+        return true;
+    }
+
     public static void Refresh(Assembly assembly)
     {
         if (!Core.IsInitialized)
@@ -0,0 +1,26 @@
+﻿namespace UNET;
+
+/// <summary>
+/// Kinds of processes that load plugin, values must match <c>UNET::EManagedHostTarget</c>
+/// </summary>
+[Flags]
+public enum PluginTargets
+{
+    None = 0,
+
+    Editor = 1 << 0,
+
+    /// <summary>
+    /// Standalone game, that can be both client and listen server
+    /// </summary>
+    Game = 1 << 1,
+
+    Client = 1 << 2,
+
+    /// <summary>
+    /// Dedicated server
+    /// </summary>
+    Server = 1 << 3,
+
+    All = Editor | Game | Client | Server
+}
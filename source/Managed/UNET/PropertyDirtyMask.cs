@@ -0,0 +1,51 @@
+﻿using System.Runtime.CompilerServices;
+
+namespace UNET;
+
+/// <summary>
+/// Dirty bits of exposed properties, stored in object right after properties of each managed class
+/// </summary>
+/// <remarks>
+/// Source generator marks property in its setter, so writes are tracked without calls to native code.
+/// Native observers read and clear bits with <c>UUNETClass::ForEachDirtyProperty</c>.
+/// Offset of bits is <c>FManagedClassInfo::DirtyMaskOffset</c> filled on class registration,
+/// it exists only when <see cref="IMetadataProvider.ClassInfoVersion"/> is at least <see cref="ClassInfoVersion.DirtyMask"/>,
+/// index of property is its index in properties of the class that declares it.
+/// </remarks>
+/// <example>
+/// <code>
+/// public int Health
+/// {
+///     get => _properties->Health;
+///     set
+///     {
+///         _properties->Health = value;
+///         PropertyDirtyMask.MarkDirty(NativePointer, DirtyMaskOffset, 0);
+///     }
+/// }
+/// </code>
+/// </example>
+public static unsafe class PropertyDirtyMask
+{
+    private const int BitsPerWord = 64;
+
+    /// <summary>
+    /// Marks property of <paramref name="target"/> as changed
+    /// </summary>
+    /// <param name="target">Pointer to UObject</param>
+    /// <param name="maskOffset">Offset of dirty bits of class that declares the property</param>
+    /// <param name="propertyIndex">Index of property in its class</param>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void MarkDirty(nint target, int maskOffset, int propertyIndex)
+    {
+        var word = (ulong*)(target + maskOffset) + propertyIndex / BitsPerWord;
+        *word |= 1UL << (propertyIndex % BitsPerWord);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool IsDirty(nint target, int maskOffset, int propertyIndex)
+    {
+        var word = (ulong*)(target + maskOffset) + propertyIndex / BitsPerWord;
+        return (*word & (1UL << (propertyIndex % BitsPerWord))) != 0;
+    }
+}
@@ -0,0 +1,66 @@
+﻿namespace UNET;
+
+/// <summary>
+/// Push model handle of replicated property, resolved once when managed class is registered
+/// </summary>
+/// <remarks>
+/// Source generator creates handle for each property declared with push based replication
+/// and marks it dirty in property setter, so replication doesn't compare the property every net update.
+/// Without push model enabled in engine, marking is ignored and the property is compared as usual.
+/// </remarks>
+/// <example>
+/// <code>
+/// private static readonly ReplicatedProperty HealthProperty = ReplicatedProperty.Resolve(StaticClass, nameof(Health));
+///
+/// public float Health
+/// {
+///     get => _properties->Health;
+///     set
+///     {
+///         _properties->Health = value;
+///         HealthProperty.MarkDirty(NativePointer);
+///     }
+/// }
+/// </code>
+/// </example>
+public sealed class ReplicatedProperty
+{
+    private const int InvalidRepIndex = -1;
+
+    private ReplicatedProperty(int repIndex)
+    {
+        RepIndex = repIndex;
+    }
+
+    /// <summary>
+    /// Index of property in replication data of its class, or -1 when property is not replicated
+    /// </summary>
+    public int RepIndex { get; }
+
+    public bool IsValid => RepIndex != InvalidRepIndex;
+
+    /// <summary>
+    /// Resolves replication index of property
+    /// </summary>
+    /// <param name="managedClass">Pointer to UClass that declares or inherits the property</param>
+    /// <param name="propertyName">Name of property with <c>CPF_Net</c> flag</param>
+    /// <exception cref="MissingMemberException">Property is not found or is not replicated</exception>
+    public static ReplicatedProperty Resolve(nint managedClass, string propertyName)
+    {
+        var repIndex = Core.NativeDelegates.GetRepIndex(managedClass, propertyName);
+
+        if (repIndex == InvalidRepIndex)
+        {
+            throw new MissingMemberException($"Class has no replicated property {propertyName}");
+        }
+
+        return new ReplicatedProperty(repIndex);
+    }
+
+    /// <summary>
+    /// Tells replication that property of <paramref name="target"/> is changed
+    /// </summary>
+    /// <param name="target">Pointer to UObject</param>
+    public void MarkDirty(nint target)
+        => Core.NativeDelegates.MarkPropertyDirty(target, RepIndex);
+}
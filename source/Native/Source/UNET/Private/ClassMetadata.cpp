@@ -0,0 +1,563 @@
+#include "ClassMetadata.h"
+
+#include <Async/MappedFileHandle.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/ScopeExit.h>
+#include <Templates/IntegerSequence.h>
+
+#include "Delegates.h"
+#include "ClassRegistry.h"
+#include "LogUNET.h"
+
+namespace {
+
+    using namespace UECodeGen_Private;
+    using UNET::FClassMetadataHeader;
+    using UNET::FClassMetadataRecord;
+    using UNET::FPropertyMetadataRecord;
+
+    /**
+     *   Bytes of .unetmeta file, mapped when platform supports it, otherwise read into memory.
+     */
+    class FMetadataBlob {
+
+        TUniquePtr<IMappedFileHandle> MappedFile;
+        TUniquePtr<IMappedFileRegion> MappedRegion;
+        TArray<uint8> Data;
+
+    public:
+
+        bool Load(const FString& Path) {
+#if !WITH_EDITOR
+            // Editor rebuilds plugins while it is running, and mapped file can't be overwritten on some platforms
+            MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+
+            if (MappedFile) {
+                MappedRegion.Reset(MappedFile->MapRegion());
+
+                if (MappedRegion) {
+                    return true;
+                }
+
+                MappedFile.Reset();
+            }
+#endif
+
+            return FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent);
+        }
+
+        void Load(TArray<uint8>&& InData) {
+            Data = MoveTemp(InData);
+        }
+
+        const uint8* GetData() const {
+            return MappedRegion ? MappedRegion->GetMappedPtr() : Data.GetData();
+        }
+
+        uint64 Num() const {
+            return MappedRegion ? MappedRegion->GetMappedSize() : Data.Num();
+        }
+    };
+
+    union FPropertyParamsStorage {
+        FGenericPropertyParams Generic;
+        FObjectPropertyParams Object;
+    };
+
+    /**
+     *   FManagedClassInfo created from blob, with storage for everything it points to.
+     */
+    struct FMetadataClass {
+        FManagedClassInfo Info;
+        FClassRegistrationInfo RegistrationInfo;
+
+        TArray<FPropertyParamsStorage> PropertyParams;
+        TArray<const FPropertyParamsBase*> PropertyArray;
+        TArray<FManagedReplicationParams> ReplicationParams;
+
+        int32 PropertiesOffset;
+
+        // Names point to blob, so it is freed when all its classes are reloaded from another one
+        TSharedPtr<FMetadataBlob> Blob;
+    };
+
+    // Indexed by thunk slot. UE keeps pointer to registration info, so entry of reloaded class is reused instead of freed
+    TArray<TUniquePtr<FMetadataClass>> Classes;
+
+    TArray<int32> LastPropertiesOffsets;
+
+    const FCppClassTypeInfoStatic ManagedCppClassTypeInfo = { false };
+
+    // UE calls registration functions without arguments, so each class gets its own pair of functions from a fixed pool
+    constexpr int32 MaxRegisterThunks = 1024;
+
+    FManagedClassInfo* ThunkInfos[MaxRegisterThunks];
+    TMap<FName, int32> ThunkSlots;
+
+    template<int32 Index>
+    UClass* OuterRegisterThunk() {
+        return UNET::OuterRegisterInternal(ThunkInfos[Index]);
+    }
+
+    template<int32 Index>
+    UClass* InnerRegisterThunk() {
+        return UNET::InnerRegisterInternal(ThunkInfos[Index]);
+    }
+
+    typedef UClass* (*FRegisterThunk)();
+
+    template<int32... Indices>
+    struct TRegisterThunks {
+        static constexpr FRegisterThunk Outer[] = { &OuterRegisterThunk<Indices>... };
+        static constexpr FRegisterThunk Inner[] = { &InnerRegisterThunk<Indices>... };
+    };
+
+    template<int32... Indices>
+    TRegisterThunks<Indices...> MakeRegisterThunks(TIntegerSequence<int32, Indices...>);
+
+    using FRegisterThunks = decltype(MakeRegisterThunks(TMakeIntegerSequence<int32, MaxRegisterThunks>()));
+
+    // Only types that managed code can write as a plain value or pointer, alignment is the same as size
+    int32 GetPropertySize(uint32 GenFlags) {
+        switch ((EPropertyGenFlags)GenFlags & EPropertyGenFlags::TypeMask) {
+        case EPropertyGenFlags::Byte:
+        case EPropertyGenFlags::Int8:
+            return 1;
+        case EPropertyGenFlags::Int16:
+        case EPropertyGenFlags::UInt16:
+            return 2;
+        case EPropertyGenFlags::Int:
+        case EPropertyGenFlags::UInt32:
+        case EPropertyGenFlags::Float:
+            return 4;
+        case EPropertyGenFlags::Int64:
+        case EPropertyGenFlags::UInt64:
+        case EPropertyGenFlags::Double:
+            return 8;
+        case EPropertyGenFlags::Object:
+            return sizeof(UObject*);
+        default:
+            return 0;
+        }
+    }
+
+    /**
+     *   Bounds-checked view of blob, used while it is validated.
+     */
+    class FMetadataReader {
+
+        const uint8* Data;
+        uint64 Size;
+
+    public:
+
+        const FClassMetadataHeader* Header = nullptr;
+        const FClassMetadataRecord* ClassRecords = nullptr;
+        const FPropertyMetadataRecord* PropertyRecords = nullptr;
+
+        FMetadataReader(const FMetadataBlob& Blob) :
+            Data(Blob.GetData()),
+            Size(Blob.Num()) {}
+
+        bool IsInRange(uint64 Offset, uint64 Length) const {
+            return Offset <= Size && Length <= Size - Offset;
+        }
+
+        template<typename T>
+        bool IsValidString(uint32 Offset) const {
+            if (Offset % alignof(T) || !IsInRange((uint64)Header->StringsOffset + Offset, sizeof(T)) || Offset >= Header->StringsSize) {
+                return false;
+            }
+
+            auto String = (const T*)(Data + Header->StringsOffset + Offset);
+            auto End = (const T*)(Data + Header->StringsOffset + Header->StringsSize);
+
+            for (; String < End; String++) {
+                if (!*String) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        template<typename T>
+        const T* GetString(uint32 Offset) const {
+            return Offset == FClassMetadataRecord::InvalidOffset ? nullptr : (const T*)(Data + Header->StringsOffset + Offset);
+        }
+
+        const uint8* GetDefaultValues(const FClassMetadataRecord& Class) const {
+            return Class.DefaultValues == FClassMetadataRecord::InvalidOffset ? nullptr : Data + Header->DataOffset + Class.DefaultValues;
+        }
+
+        bool ReadHeader() {
+            if (!IsInRange(0, sizeof(FClassMetadataHeader)) || (uintptr_t)Data % alignof(uint64)) {
+                return false;
+            }
+
+            Header = (const FClassMetadataHeader*)Data;
+
+            if (Header->Magic != FClassMetadataHeader::ExpectedMagic) {
+                UE_LOG(LogUNET, Error, TEXT("Class metadata has unknown format"));
+                return false;
+            }
+
+            if (Header->Version != FClassMetadataHeader::CurrentVersion || Header->HeaderSize != sizeof(FClassMetadataHeader)) {
+                UE_LOG(LogUNET, Error, TEXT("Class metadata version %d is not supported, expected %d"), Header->Version, FClassMetadataHeader::CurrentVersion);
+                return false;
+            }
+
+            if (Header->ClassesOffset % alignof(FClassMetadataRecord) || Header->PropertiesOffset % alignof(FPropertyMetadataRecord) ||
+                Header->StringsOffset % alignof(TCHAR) ||
+                !IsInRange(Header->ClassesOffset, (uint64)Header->NumClasses * sizeof(FClassMetadataRecord)) ||
+                !IsInRange(Header->PropertiesOffset, (uint64)Header->NumProperties * sizeof(FPropertyMetadataRecord)) ||
+                !IsInRange(Header->StringsOffset, Header->StringsSize) ||
+                !IsInRange(Header->DataOffset, Header->DataSize)) {
+                UE_LOG(LogUNET, Error, TEXT("Class metadata is truncated"));
+                return false;
+            }
+
+            ClassRecords = (const FClassMetadataRecord*)(Data + Header->ClassesOffset);
+            PropertyRecords = (const FPropertyMetadataRecord*)(Data + Header->PropertiesOffset);
+
+            return true;
+        }
+
+        bool ValidateClass(int32 Index) const {
+            auto& Class = ClassRecords[Index];
+
+            if (!IsValidString<TCHAR>(Class.PackageName) || !IsValidString<TCHAR>(Class.ClassName) || !IsValidString<TCHAR>(Class.ParentName) ||
+                (Class.ConfigName != FClassMetadataRecord::InvalidOffset && !IsValidString<TCHAR>(Class.ConfigName))) {
+                UE_LOG(LogUNET, Error, TEXT("Class metadata #%d has invalid names"), Index);
+                return false;
+            }
+
+            auto ClassName = GetString<TCHAR>(Class.ClassName);
+
+            // Classes share thunk slot by name, so the second one would overwrite the first
+            for (int32 i = 0; i < Index; i++) {
+                if (FCString::Stricmp(GetString<TCHAR>(ClassRecords[i].ClassName), ClassName) == 0) {
+                    UE_LOG(LogUNET, Error, TEXT("Managed class %s is declared twice in class metadata"), ClassName);
+                    return false;
+                }
+            }
+
+            if (Class.ParentIndex >= Index || Class.ParentIndex < INDEX_NONE) {
+                UE_LOG(LogUNET, Error, TEXT("Parent of managed class %s must be written before it"), ClassName);
+                return false;
+            }
+
+            if (!FMath::IsPowerOfTwo(Class.LayoutAlignment) || Class.LayoutAlignment > alignof(uint64) ||
+                (uint64)Class.FirstProperty + Class.NumProperties > Header->NumProperties ||
+                (Class.DefaultValues != FClassMetadataRecord::InvalidOffset && (uint64)Class.DefaultValues + Class.LayoutSize > Header->DataSize)) {
+                UE_LOG(LogUNET, Error, TEXT("Managed class %s has invalid layout"), ClassName);
+                return false;
+            }
+
+            for (uint32 i = Class.FirstProperty; i < Class.FirstProperty + Class.NumProperties; i++) {
+                auto& Property = PropertyRecords[i];
+                auto PropertySize = GetPropertySize(Property.GenFlags);
+
+                if (!PropertySize) {
+                    UE_LOG(LogUNET, Error, TEXT("Property #%d of managed class %s has type that is not supported by precompiled metadata"), i - Class.FirstProperty, ClassName);
+                    return false;
+                }
+
+                if (!IsValidString<UTF8CHAR>(Property.Name) ||
+                    (Property.RepNotifyName != FClassMetadataRecord::InvalidOffset && !IsValidString<UTF8CHAR>(Property.RepNotifyName)) ||
+                    Property.ArrayDim < 1 || Property.Offset % PropertySize || (uint32)PropertySize > Class.LayoutAlignment ||
+                    (uint64)Property.Offset + (uint64)PropertySize * Property.ArrayDim > Class.LayoutSize) {
+                    UE_LOG(LogUNET, Error, TEXT("Property #%d of managed class %s is invalid"), i - Class.FirstProperty, ClassName);
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    void CreateClass(const FMetadataReader& Reader, const TSharedRef<FMetadataBlob>& Blob, int32 Index, UClass* BaseClass, int32 ThunkSlot) {
+        auto& Record = Reader.ClassRecords[Index];
+
+        if (ThunkSlot == Classes.Num()) {
+            Classes.Add(MakeUnique<FMetadataClass>());
+        }
+
+        auto& Class = *Classes[ThunkSlot];
+        auto& Info = Class.Info;
+
+        FMemory::Memzero(Info);
+
+        // Singletons are set again when class is reused, otherwise new class is constructed
+        Class.RegistrationInfo = FClassRegistrationInfo();
+        Class.PropertyParams.Reset();
+        Class.PropertyArray.Reset();
+        Class.ReplicationParams.Reset();
+
+        // Previous blob is freed here unless other classes still use it
+        Class.Blob = Blob;
+
+        Info.ClassName = Reader.GetString<TCHAR>(Record.ClassName);
+        Info.PackageName = Reader.GetString<TCHAR>(Record.PackageName);
+        Info.ParentName = Reader.GetString<TCHAR>(Record.ParentName);
+        // The same way as managed metadata, config name is passed as TCHAR
+        Info.ClassConfigNameUTF8 = (const char*)Reader.GetString<TCHAR>(Record.ConfigName);
+        Info.ClassFlags = Record.ClassFlags;
+        Info.CastFlags = (EClassCastFlags)Record.CastFlags;
+        Info.CppClassInfo = &ManagedCppClassTypeInfo;
+
+        Info.RegistrationInfo = &Class.RegistrationInfo;
+        Info.OuterRegister = FRegisterThunks::Outer[ThunkSlot];
+        Info.InnerRegister = FRegisterThunks::Inner[ThunkSlot];
+        Info.ClassNoregisterFunc = Info.InnerRegister;
+
+        ThunkInfos[ThunkSlot] = &Info;
+
+        // Layout was resolved by generator, only the start of the block depends on parent
+        Info.BaseClass = BaseClass;
+        Class.PropertiesOffset = Align(BaseClass->PropertiesSize, (int32)Record.LayoutAlignment);
+        Info.PropertiesSize = Class.PropertiesOffset + Record.LayoutSize;
+        Info.MinAlignment = FMath::Max(BaseClass->MinAlignment, (int32)Record.LayoutAlignment);
+
+        Class.PropertyParams.SetNumZeroed(Record.NumProperties);
+        Class.PropertyArray.Reserve(Record.NumProperties);
+        Class.ReplicationParams.Reserve(Record.NumProperties);
+
+        for (uint32 i = 0; i < Record.NumProperties; i++) {
+            auto& Property = Reader.PropertyRecords[Record.FirstProperty + i];
+            auto& Params = Class.PropertyParams[i];
+
+            Params.Generic.NameUTF8 = (const char*)Reader.GetString<UTF8CHAR>(Property.Name);
+            Params.Generic.RepNotifyFuncUTF8 = (const char*)Reader.GetString<UTF8CHAR>(Property.RepNotifyName);
+            Params.Generic.PropertyFlags = GetReplicationFlags((EPropertyFlags)Property.PropertyFlags, Params.Generic.RepNotifyFuncUTF8);
+            Params.Generic.Flags = (EPropertyGenFlags)(Property.GenFlags & FPropertyMetadataRecord::GenFlagsMask);
+            Params.Generic.ObjectFlags = (EObjectFlags)Property.ObjectFlags;
+            Params.Generic.ArrayDim = Property.ArrayDim;
+            Params.Generic.Offset = Class.PropertiesOffset + Property.Offset;
+
+            // Generator doesn't know the exact class, but UE needs it to describe property to GC and serializers
+            if ((Params.Generic.Flags & EPropertyGenFlags::TypeMask) == EPropertyGenFlags::Object) {
+                Params.Object.ClassFunc = &UObject::StaticClass;
+            }
+
+            Class.PropertyArray.Add(&Params.Generic);
+            Class.ReplicationParams.Add({
+                (uint8)(Property.GenFlags >> FPropertyMetadataRecord::ConditionShift),
+                (uint8)(Property.GenFlags >> FPropertyMetadataRecord::RepNotifyConditionShift),
+                (uint8)((Property.GenFlags & FPropertyMetadataRecord::PushBasedFlag) != 0)
+            });
+        }
+
+        Info.PropertyArray = Class.PropertyArray.GetData();
+        Info.ReplicationParams = Class.ReplicationParams.GetData();
+        Info.NumProperties = Record.NumProperties;
+        Info.AddDirtyMask(EManagedClassInfoVersion::Latest);
+
+        // Own default values start at the end of parent, padding before the block is zeroed
+        TArray<uint8> DefaultValues;
+        DefaultValues.SetNumZeroed(Info.PropertiesSize - BaseClass->PropertiesSize);
+
+        if (auto BlobDefaultValues = Reader.GetDefaultValues(Record)) {
+            FMemory::Memcpy(DefaultValues.GetData() + Class.PropertiesOffset - BaseClass->PropertiesSize, BlobDefaultValues, Record.LayoutSize);
+        }
+
+        UNET::RegisterResolvedClass(&Info, MoveTemp(DefaultValues), EManagedClassInfoVersion::Latest);
+
+        LastPropertiesOffsets.Add(Class.PropertiesOffset);
+    }
+
+    const int32* RegisterBlob(const TSharedRef<FMetadataBlob>& Blob, int32& OutNumClasses) {
+        FMetadataReader Reader(*Blob);
+
+        if (!Reader.ReadHeader()) {
+            return nullptr;
+        }
+
+        auto NumClasses = (int32)Reader.Header->NumClasses;
+
+        TArray<UClass*, TInlineAllocator<32>> NativeParents;
+        TArray<int32, TInlineAllocator<32>> Slots;
+        NativeParents.SetNumZeroed(NumClasses);
+        Slots.SetNumUninitialized(NumClasses);
+
+        auto NumFreeSlots = MaxRegisterThunks - Classes.Num();
+
+        // Nothing is registered until the whole blob is checked
+        for (int32 i = 0; i < NumClasses; i++) {
+            if (!Reader.ValidateClass(i)) {
+                return nullptr;
+            }
+
+            auto& Record = Reader.ClassRecords[i];
+            auto ClassName = Reader.GetString<TCHAR>(Record.ClassName);
+
+            if (Record.ParentIndex == INDEX_NONE) {
+                auto ParentName = Reader.GetString<TCHAR>(Record.ParentName);
+                NativeParents[i] = FindFirstObject<UClass>(ParentName, EFindFirstObjectOptions::NativeFirst);
+
+                if (!NativeParents[i]) {
+                    UE_LOG(LogUNET, Error, TEXT("Parent %s of managed class %s is not found"), ParentName, ClassName);
+                    return nullptr;
+                }
+            }
+
+            // Slot is reused on reload, so reloaded class doesn't take new one
+            if (auto Slot = ThunkSlots.Find(ClassName)) {
+                Slots[i] = *Slot;
+            }
+            else if (NumFreeSlots-- > 0) {
+                Slots[i] = INDEX_NONE;
+            }
+            else {
+                UE_LOG(LogUNET, Error, TEXT("Too many managed classes are registered from precompiled metadata, at most %d are supported"), MaxRegisterThunks);
+                return nullptr;
+            }
+        }
+
+        LastPropertiesOffsets.Reset(NumClasses);
+
+        for (int32 i = 0; i < NumClasses; i++) {
+            auto StartTime = FPlatformTime::Seconds();
+            ON_SCOPE_EXIT { UNET::ClassRegistry::AddRegistrationTime(FPlatformTime::Seconds() - StartTime); };
+
+            auto& Record = Reader.ClassRecords[i];
+
+            if (Slots[i] == INDEX_NONE) {
+                Slots[i] = ThunkSlots.Add(Reader.GetString<TCHAR>(Record.ClassName), Classes.Num());
+            }
+
+            // Parent from the same plugin is registered already, but UE constructs its UClass only on demand
+            auto BaseClass = Record.ParentIndex == INDEX_NONE ?
+                NativeParents[i] :
+                UNET::InnerRegisterInternal(&Classes[Slots[Record.ParentIndex]]->Info);
+
+            CreateClass(Reader, Blob, i, BaseClass, Slots[i]);
+        }
+
+        OutNumClasses = NumClasses;
+        return LastPropertiesOffsets.GetData();
+    }
+
+    /**
+     *   String pool of blob written by ClassMetadata::Write.
+     */
+    class FMetadataStringPool {
+
+        TArray<uint8> Data;
+
+        template<typename T>
+        uint32 Add(const T* String, int32 Length) {
+            Data.SetNumZeroed(Align(Data.Num(), (int32)alignof(T)));
+
+            auto Offset = (uint32)Data.Num();
+            Data.Append((const uint8*)String, Length * sizeof(T));
+            Data.AddZeroed(sizeof(T));
+
+            return Offset;
+        }
+
+    public:
+
+        uint32 Add(const TCHAR* String) {
+            return Add(String, FCString::Strlen(String));
+        }
+
+        uint32 Add(const char* String) {
+            return String ? Add((const UTF8CHAR*)String, FCStringAnsi::Strlen(String)) : FClassMetadataRecord::InvalidOffset;
+        }
+
+        const TArray<uint8>& GetData() const {
+            return Data;
+        }
+    };
+}
+
+const int32* UNET::ClassMetadata::Register(const FString& Path, int32& OutNumClasses) {
+    OutNumClasses = 0;
+
+    auto Blob = MakeShared<FMetadataBlob>();
+
+    if (!Blob->Load(Path)) {
+        UE_LOG(LogUNET, Error, TEXT("Failed to read class metadata from %s"), *Path);
+        return nullptr;
+    }
+
+    auto PropertiesOffsets = RegisterBlob(Blob, OutNumClasses);
+
+    if (!PropertiesOffsets) {
+        UE_LOG(LogUNET, Error, TEXT("Class metadata %s can't be used"), *Path);
+    }
+
+    return PropertiesOffsets;
+}
+
+const int32* UNET::ClassMetadata::Register(TArray<uint8>&& Data, int32& OutNumClasses) {
+    OutNumClasses = 0;
+
+    auto Blob = MakeShared<FMetadataBlob>();
+    Blob->Load(MoveTemp(Data));
+
+    return RegisterBlob(Blob, OutNumClasses);
+}
+
+TArray<uint8> UNET::ClassMetadata::Write(const TCHAR* PackageName, const TCHAR* ClassName, const TCHAR* ParentName, TArrayView<const FPropertyDeclaration> Properties) {
+    FMetadataStringPool Strings;
+
+    FClassMetadataRecord Class = {};
+    Class.PackageName = Strings.Add(PackageName);
+    Class.ClassName = Strings.Add(ClassName);
+    Class.ParentName = Strings.Add(ParentName);
+    Class.ConfigName = FClassMetadataRecord::InvalidOffset;
+    Class.ParentIndex = INDEX_NONE;
+    Class.NumProperties = Properties.Num();
+    Class.LayoutAlignment = 1;
+    Class.DefaultValues = FClassMetadataRecord::InvalidOffset;
+
+    TArray<FPropertyMetadataRecord> PropertyRecords;
+
+    for (auto& Property : Properties) {
+        auto Size = (uint32)GetPropertySize((uint32)Property.Type);
+
+        auto& Record = PropertyRecords.AddZeroed_GetRef();
+        Record.Name = Strings.Add(Property.Name);
+        Record.RepNotifyName = Strings.Add(Property.RepNotifyName);
+        Record.PropertyFlags = Property.Flags;
+        Record.GenFlags = (uint32)Property.Type | (uint32)Property.Condition << FPropertyMetadataRecord::ConditionShift;
+        Record.ArrayDim = 1;
+        Record.Offset = Property.Offset;
+
+        Class.LayoutSize = FMath::Max(Class.LayoutSize, Property.Offset + Size);
+        Class.LayoutAlignment = FMath::Max(Class.LayoutAlignment, Size);
+    }
+
+    Class.LayoutSize = Align(Class.LayoutSize, Class.LayoutAlignment);
+
+    FClassMetadataHeader Header = {};
+    Header.Magic = FClassMetadataHeader::ExpectedMagic;
+    Header.Version = FClassMetadataHeader::CurrentVersion;
+    Header.HeaderSize = sizeof(FClassMetadataHeader);
+    Header.NumClasses = 1;
+    Header.NumProperties = PropertyRecords.Num();
+    Header.ClassesOffset = sizeof(FClassMetadataHeader);
+    Header.PropertiesOffset = Header.ClassesOffset + sizeof(FClassMetadataRecord);
+    Header.StringsOffset = Header.PropertiesOffset + PropertyRecords.Num() * sizeof(FPropertyMetadataRecord);
+    Header.StringsSize = Strings.GetData().Num();
+    Header.DataOffset = Header.StringsOffset + Header.StringsSize;
+    Header.DataSize = 0;
+
+    TArray<uint8> Blob;
+    Blob.Append((const uint8*)&Header, sizeof(Header));
+    Blob.Append((const uint8*)&Class, sizeof(Class));
+    Blob.Append((const uint8*)PropertyRecords.GetData(), PropertyRecords.Num() * sizeof(FPropertyMetadataRecord));
+    Blob.Append(Strings.GetData());
+
+    return Blob;
+}
+
+/**
+* Called by C# Plugin Loader when plugin has precompiled metadata
+*/
+const int32* UNET::RegisterClassMetadata(const TCHAR* Path, int32 PathLength, int32* OutNumClasses) {
+    return ClassMetadata::Register(FString(PathLength, Path), *OutNumClasses);
+}
@@ -0,0 +1,112 @@
+#include "ClassRegistry.h"
+
+#include "Delegates.h"
+#include "LogUNET.h"
+
+TMap<FName, UNET::ClassRegistry::FEntry> UNET::ClassRegistry::Entries;
+TMap<FName, int32> UNET::ClassRegistry::DeferredClasses;
+
+int32 UNET::ClassRegistry::NumRegistrations = 0;
+double UNET::ClassRegistry::RegistrationSeconds = 0.0;
+
+void UNET::ClassRegistry::Add(FManagedClassInfo* Info, EManagedClassInfoVersion Version, TArray<uint8>&& DefaultValues, UClass* Class) {
+    auto& Entry = Entries.FindOrAdd(Info->ClassName);
+    Entry.Info = Info;
+    Entry.Version = Version;
+    Entry.Class = Class;
+    Entry.DefaultValues = MoveTemp(DefaultValues);
+}
+
+void UNET::ClassRegistry::SetClass(FManagedClassInfo* Info, UClass* Class) {
+    auto Entry = Entries.Find(Info->ClassName);
+
+    check(Entry && Entry->Info == Info);
+
+    Entry->Class = Class;
+}
+
+UClass* UNET::ClassRegistry::FindClass(FName ClassName) {
+    auto Entry = Entries.Find(ClassName);
+    return Entry ? Entry->Class : nullptr;
+}
+
+FManagedClassInfo* UNET::ClassRegistry::FindInfo(FName ClassName) {
+    auto Entry = Entries.Find(ClassName);
+    return Entry ? Entry->Info : nullptr;
+}
+
+const TArray<uint8>& UNET::ClassRegistry::GetDefaultValues(FName ClassName) {
+    static const TArray<uint8> Empty;
+
+    auto Entry = Entries.Find(ClassName);
+    return Entry ? Entry->DefaultValues : Empty;
+}
+
+EManagedClassInfoVersion UNET::ClassRegistry::GetVersion(FName ClassName) {
+    auto Entry = Entries.Find(ClassName);
+    return Entry ? Entry->Version : EManagedClassInfoVersion::Latest;
+}
+
+void UNET::ClassRegistry::AddDeferred(FName ClassName, int32 PluginId) {
+    DeferredClasses.Add(ClassName, PluginId);
+}
+
+UClass* UNET::ClassRegistry::LoadDeferredClass(FName ClassName) {
+    if (auto Class = FindClass(ClassName)) {
+        return Class;
+    }
+
+    int32 PluginId;
+
+    // Delegates are filled by C# side, deferred classes stay deferred until runtime is loaded
+    if (UNET::PluginLoaderDelegates.LoadDeferredPlugin && DeferredClasses.RemoveAndCopyValue(ClassName, PluginId)) {
+        // Plugin registers all its classes at once, so none of them is deferred anymore
+        for (auto It = DeferredClasses.CreateIterator(); It; ++It) {
+            if (It->Value == PluginId) {
+                It.RemoveCurrent();
+            }
+        }
+
+        auto StartTime = FPlatformTime::Seconds();
+
+        {
+            static const FName CallName = TEXT("LoadDeferredPlugin");
+            FManagedCallScope CallScope(CallName);
+
+            UNET::PluginLoaderDelegates.LoadDeferredPlugin(PluginId);
+        }
+
+        UE_LOG(LogUNET, Log, TEXT("Managed plugin is loaded on demand for class %s in %.2f ms"),
+            *ClassName.ToString(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    }
+
+    auto Info = FindInfo(ClassName);
+
+    if (!Info) {
+        return nullptr;
+    }
+
+    // The same call as generated StaticClass makes, class is created the first time it is requested
+    return Info->InnerRegister();
+}
+
+void UNET::ClassRegistry::Reset() {
+    // Ids of deferred plugins are valid only until plugins are unloaded
+    DeferredClasses.Reset();
+
+    for (auto It = Entries.CreateIterator(); It; ++It) {
+        It->Value.Info = nullptr;
+
+        // class was never constructed, so there is nothing to keep
+        if (!It->Value.Class) {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+/**
+* Called by C# plugin loader for classes declared in manifest of plugin that is loaded on demand
+*/
+void UNET::RegisterDeferredClass(const TCHAR* ClassName, int32 NameLength, int32 PluginId) {
+    UNET::ClassRegistry::AddDeferred(FName(NameLength, ClassName), PluginId);
+}
@@ -2,7 +2,10 @@
 
 DEFINE_LOG_CATEGORY(LogUNETManaged);
 
-static void UNET::LogManaged(ELogVerbosity::Type level, TCHAR* message) {
+const struct UNET::NativeDelegates UNET::NativeDelegates {};
+struct UNET::PluginLoaderDelegates UNET::PluginLoaderDelegates {};
+
+void UNET::LogManaged(ELogVerbosity::Type level, TCHAR* message) {
     switch (level)
     {
     case ELogVerbosity::Fatal:
@@ -39,4 +42,33 @@ static void UNET::LogManaged(ELogVerbosity::Type level, TCHAR* message) {
     default:
         break;
     }
-}
\ No newline at end of file
+}
+
+/**
+* Does nothing, used to measure cost of managed to native call
+*/
+void UNET::Ping() {}
+
+/**
+* Called by C# plugin loader before plugins are loaded
+*/
+void UNET::GetHostInfo(FManagedHostInfo* OutInfo) {
+    static const FString Platform = FPlatformProperties::IniPlatformName();
+
+    if (GIsEditor) {
+        OutInfo->Target = EManagedHostTarget::Editor;
+    }
+    else if (IsRunningDedicatedServer()) {
+        OutInfo->Target = EManagedHostTarget::Server;
+    }
+    else if (IsRunningClientOnly()) {
+        OutInfo->Target = EManagedHostTarget::Client;
+    }
+    else {
+        // Standalone game can be both client and listen server
+        OutInfo->Target = EManagedHostTarget::Game;
+    }
+
+    OutInfo->Platform = *Platform;
+    OutInfo->PlatformLength = Platform.Len();
+}
@@ -10,6 +10,10 @@ void HostFXR::Load(FString HostPath)
 {
     Handle = FPlatformProcess::GetDllHandle(*HostPath);
 
+    if (!Handle) {
+        return;
+    }
+
     _initializeForRuntimeConfig = (hostfxr_initialize_for_runtime_config_fn)FPlatformProcess::GetDllExport(Handle, TEXT("hostfxr_initialize_for_runtime_config"));
     _getRuntimeDelegate = (hostfxr_get_runtime_delegate_fn)FPlatformProcess::GetDllExport(Handle, TEXT("hostfxr_get_runtime_delegate"));
     _closeRuntime = (hostfxr_close_fn)FPlatformProcess::GetDllExport(Handle, TEXT("hostfxr_close"));
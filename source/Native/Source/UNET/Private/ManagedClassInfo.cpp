@@ -1,26 +1,140 @@
 #include "ManagedClassInfo.h"
+#include "ClassRegistry.h"
 
-void FManagedClassInfo::Initialize() {
-    BaseClass = (UClass*)StaticFindObject(UObject::StaticClass(), ANY_PACKAGE, ParentName, false);
+#include <UObject/LazyObjectPtr.h>
+#include <UObject/SoftObjectPtr.h>
+
+namespace {
+
+    using namespace UECodeGen_Private;
+
+    // Size and alignment of UE type that stores reference, for types which params are FObjectPropertyParams or have ClassFunc at the same place.
+    // Returns false for other types
+    bool GetReferenceLayout(const FPropertyParamsBase* Property, int32& OutSize, int32& OutAlignment) {
+        switch (Property->Flags & EPropertyGenFlags::TypeMask) {
+        case EPropertyGenFlags::Object:
+        case EPropertyGenFlags::Class:
+            OutSize = sizeof(UObject*);
+            OutAlignment = alignof(UObject*);
+            return true;
+        case EPropertyGenFlags::WeakObject:
+            OutSize = sizeof(FWeakObjectPtr);
+            OutAlignment = alignof(FWeakObjectPtr);
+            return true;
+        case EPropertyGenFlags::LazyObject:
+            OutSize = sizeof(FLazyObjectPtr);
+            OutAlignment = alignof(FLazyObjectPtr);
+            return true;
+        case EPropertyGenFlags::SoftObject:
+            OutSize = sizeof(FSoftObjectPtr);
+            OutAlignment = alignof(FSoftObjectPtr);
+            return true;
+        default:
+            return false;
+        }
+    }
+}
+
+void FManagedClassInfo::Initialize(TArray<uint8>& OutDefaultValues, EManagedClassInfoVersion Version) {
+    BaseClass = FindFirstObject<UClass>(ParentName, EFindFirstObjectOptions::NativeFirst);
+
+    // Parent can be declared by plugin that is loaded on demand
+    if (!BaseClass) {
+        BaseClass = UNET::ClassRegistry::LoadDeferredClass(ParentName);
+    }
 
     check(BaseClass);
 
-    SetupProperties();
+    SetupProperties(OutDefaultValues, Version);
 }
 
-void FManagedClassInfo::SetupProperties() {
+void FManagedClassInfo::AddDirtyMask(EManagedClassInfoVersion Version) {
+    // Older struct ends before DirtyMaskOffset, so it must not be written
+    if (Version < EManagedClassInfoVersion::DirtyMask) {
+        return;
+    }
+
+    if (NumProperties == 0) {
+        DirtyMaskOffset = INDEX_NONE;
+        return;
+    }
+
+    DirtyMaskOffset = Align(PropertiesSize, (int32)sizeof(uint64));
+    PropertiesSize = DirtyMaskOffset + GetDirtyMaskSize(NumProperties);
+    MinAlignment = FMath::Max(MinAlignment, (int32)sizeof(uint64));
+}
+
+uint32 FManagedClassInfo::GetLayoutHash() const {
+    auto Hash = FCrc::MemCrc32(&ClassFlags, sizeof(ClassFlags));
+
+    for (int32 i = 0; i < NumProperties; i++) {
+        auto Property = (const UECodeGen_Private::FPropertyParamsBaseWithOffset*)PropertyArray[i];
+
+        // Names are hashed as strings, so the hash doesn't depend on FName indices
+        Hash = FCrc::StrCrc32(Property->NameUTF8, Hash);
+        Hash = Property->RepNotifyFuncUTF8 ? FCrc::StrCrc32(Property->RepNotifyFuncUTF8, Hash) : Hash;
+        Hash = FCrc::MemCrc32(&Property->Flags, sizeof(Property->Flags), Hash);
+        Hash = FCrc::MemCrc32(&Property->PropertyFlags, sizeof(Property->PropertyFlags), Hash);
+        Hash = FCrc::MemCrc32(&Property->ArrayDim, sizeof(Property->ArrayDim), Hash);
+        Hash = FCrc::MemCrc32(&Property->Offset, sizeof(Property->Offset), Hash);
+    }
+
+    return Hash;
+}
+
+void FManagedClassInfo::SetupProperties(TArray<uint8>& OutDefaultValues, EManagedClassInfoVersion Version) {
     PropertiesSize = BaseClass->PropertiesSize; // position in structure
     MinAlignment = BaseClass->MinAlignment;
 
+    TArray<int32, TInlineAllocator<32>> PropertySizes;
+
     for (int i = 0; i < NumProperties; i++) {
         auto propertyInfo = (UECodeGen_Private::FPropertyParamsBaseWithOffset*)(PropertyArray[i]);
 
         // we write size of property to offset in C# (not good, but works)
         auto propertySize = propertyInfo->Offset;
 
-        // from C# we can write only basic values or pointers, so alignment is the same as size
-        propertyInfo->Offset = Align(PropertiesSize, propertySize);
-        PropertiesSize += propertySize;
-        MinAlignment = FMath::Max(MinAlignment, propertySize);
+        // basic values and pointers are aligned to their size, references are aligned as their UE types
+        auto propertyAlignment = propertySize;
+        int32 referenceSize;
+
+        auto bIsReference = GetReferenceLayout(propertyInfo, referenceSize, propertyAlignment);
+
+        // Lazy and soft references are structs, C# has to reserve their full size
+        checkf(!bIsReference || propertySize == referenceSize, TEXT("Property %hs of managed class %s takes %d bytes, but its type needs %d"),
+            propertyInfo->NameUTF8, ClassName, propertySize, referenceSize);
+
+        propertyInfo->Offset = Align(PropertiesSize, propertyAlignment);
+        PropertiesSize = propertyInfo->Offset + propertySize;
+        MinAlignment = FMath::Max(MinAlignment, propertyAlignment);
+
+        PropertySizes.Add(propertySize);
+        propertyInfo->PropertyFlags = GetReplicationFlags(propertyInfo->PropertyFlags, propertyInfo->RepNotifyFuncUTF8);
+
+        if (bIsReference) {
+            auto objectPropertyInfo = (FObjectPropertyParams*)propertyInfo;
+
+            // C# facade may not know the exact class, but UE needs it to describe property to GC and serializers
+            if (!objectPropertyInfo->ClassFunc) {
+                objectPropertyInfo->ClassFunc = &UObject::StaticClass;
+            }
+        }
+    }
+
+    AddDirtyMask(Version);
+
+    OutDefaultValues.SetNumZeroed(PropertiesSize - BaseClass->PropertiesSize);
+
+    auto DefaultValue = GetDefaultValues(Version);
+
+    if (!DefaultValue) {
+        return;
+    }
+
+    for (int i = 0; i < NumProperties; i++) {
+        auto propertyInfo = (UECodeGen_Private::FPropertyParamsBaseWithOffset*)(PropertyArray[i]);
+
+        FMemory::Memcpy(OutDefaultValues.GetData() + propertyInfo->Offset - BaseClass->PropertiesSize, DefaultValue, PropertySizes[i]);
+        DefaultValue += PropertySizes[i];
     }
 }
\ No newline at end of file
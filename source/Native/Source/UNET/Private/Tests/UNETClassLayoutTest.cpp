@@ -0,0 +1,62 @@
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <UObject/Package.h>
+#include <UObject/StrongObjectPtr.h>
+#include <UObject/UnrealType.h>
+
+#include "UNETTestClasses.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETClassLayoutChangeTest, "UNET.Classes.LayoutChange",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETClassLayoutChangeTest::RunTest(const FString& Parameters) {
+    const UNET::Tests::FTestProperty OldProperties[] = {
+        { "Value", UECodeGen_Private::EPropertyGenFlags::Int, 0 }
+    };
+
+    const UNET::Tests::FTestProperty NewProperties[] = {
+        { "Value", UECodeGen_Private::EPropertyGenFlags::Int, 0 },
+        { "Extra", UECodeGen_Private::EPropertyGenFlags::Double, 8 }
+    };
+
+    auto ClassName = TEXT("UNETTestChangingObject");
+    auto OldClass = UNET::Tests::RegisterTestClass(ClassName, TEXT("Object"), OldProperties);
+
+    if (!TestNotNull(TEXT("Managed class is registered"), OldClass)) {
+        return false;
+    }
+
+    auto OldDefaultObject = OldClass->GetDefaultObject();
+    TStrongObjectPtr<UObject> OldInstance(NewObject<UObject>(GetTransientPackage(), OldClass));
+
+    // The same class is registered again by reloaded plugin, but with another property
+    auto NewClass = UNET::Tests::RegisterTestClass(ClassName, TEXT("Object"), NewProperties);
+
+    if (!TestNotNull(TEXT("Changed managed class is registered"), NewClass)) {
+        return false;
+    }
+
+    TestNotEqual(TEXT("Changed class replaces old one"), NewClass, OldClass);
+    TestTrue(TEXT("Old class is renamed"), OldClass->GetName().StartsWith(TEXT("REINST_")));
+    TestTrue(TEXT("CDO of old class is renamed"), OldDefaultObject->GetName().StartsWith(TEXT("REINST_Default__")));
+    TestNotNull(TEXT("Changed class has new property"), FindFProperty<FDoubleProperty>(NewClass, TEXT("Extra")));
+
+    auto NewDefaultObject = NewClass->GetDefaultObject();
+
+    if (TestNotNull(TEXT("Changed class has its own CDO"), NewDefaultObject)) {
+        TestEqual(TEXT("CDO of changed class has that class"), NewDefaultObject->GetClass(), NewClass);
+        TestNotEqual(TEXT("CDO of old class is not reused"), NewDefaultObject, OldDefaultObject);
+    }
+
+    TestEqual(TEXT("Existing instance keeps old class"), OldInstance->GetClass(), OldClass);
+
+    auto NewInstance = NewObject<UObject>(GetTransientPackage(), NewClass);
+    TestEqual(TEXT("New instance gets changed class"), NewInstance->GetClass(), NewClass);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,209 @@
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClassMetadata.h"
+#include "ClassRegistry.h"
+
+namespace {
+
+    using namespace UNET;
+
+    struct FTestClassRecord {
+        const TCHAR* ClassName;
+        const TCHAR* ParentName;
+        int32 ParentIndex;
+    };
+
+    // Writes blob of several classes without properties, ClassMetadata::Write declares only one class
+    TArray<uint8> WriteClasses(TArrayView<const FTestClassRecord> Classes) {
+        TArray<uint8> Strings;
+
+        auto AddString = [&](const TCHAR* String) {
+            auto Offset = (uint32)Strings.Num();
+            Strings.Append((const uint8*)String, (FCString::Strlen(String) + 1) * sizeof(TCHAR));
+
+            return Offset;
+        };
+
+        auto PackageName = AddString(TEXT("/Script/UNETTests"));
+
+        TArray<FClassMetadataRecord> Records;
+
+        for (auto& Class : Classes) {
+            auto& Record = Records.AddZeroed_GetRef();
+            Record.PackageName = PackageName;
+            Record.ClassName = AddString(Class.ClassName);
+            Record.ParentName = AddString(Class.ParentName);
+            Record.ConfigName = FClassMetadataRecord::InvalidOffset;
+            Record.ParentIndex = Class.ParentIndex;
+            Record.LayoutAlignment = 1;
+            Record.DefaultValues = FClassMetadataRecord::InvalidOffset;
+        }
+
+        FClassMetadataHeader Header = {};
+        Header.Magic = FClassMetadataHeader::ExpectedMagic;
+        Header.Version = FClassMetadataHeader::CurrentVersion;
+        Header.HeaderSize = sizeof(FClassMetadataHeader);
+        Header.NumClasses = Records.Num();
+        Header.ClassesOffset = sizeof(FClassMetadataHeader);
+        Header.PropertiesOffset = Header.ClassesOffset + Records.Num() * sizeof(FClassMetadataRecord);
+        Header.StringsOffset = Header.PropertiesOffset;
+        Header.StringsSize = Strings.Num();
+        Header.DataOffset = Header.StringsOffset + Header.StringsSize;
+
+        TArray<uint8> Blob;
+        Blob.Append((const uint8*)&Header, sizeof(Header));
+        Blob.Append((const uint8*)Records.GetData(), Records.Num() * sizeof(FClassMetadataRecord));
+        Blob.Append(Strings);
+
+        return Blob;
+    }
+
+    TArray<uint8> WriteRejectedClass() {
+        const ClassMetadata::FPropertyDeclaration Properties[] = {
+            { "Value", UECodeGen_Private::EPropertyGenFlags::Int, 0 }
+        };
+
+        return ClassMetadata::Write(TEXT("/Script/UNETTests"), TEXT("UNETTestRejectedObject"), TEXT("Object"), Properties);
+    }
+
+    FClassMetadataHeader& GetHeader(TArray<uint8>& Blob) {
+        return *(FClassMetadataHeader*)Blob.GetData();
+    }
+
+    FClassMetadataRecord& GetClass(TArray<uint8>& Blob, int32 Index) {
+        return ((FClassMetadataRecord*)(Blob.GetData() + GetHeader(Blob).ClassesOffset))[Index];
+    }
+
+    bool IsRegistered(TArray<uint8>&& Blob) {
+        int32 NumClasses;
+        return ClassMetadata::Register(MoveTemp(Blob), NumClasses) != nullptr;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETClassMetadataHierarchyTest, "UNET.ClassMetadata.Hierarchy",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETClassMetadataHierarchyTest::RunTest(const FString& Parameters) {
+    {
+        const FTestClassRecord Classes[] = {
+            { TEXT("UNETTestMetadataParent"), TEXT("Object"), INDEX_NONE },
+            { TEXT("UNETTestMetadataChild"), TEXT("UNETTestMetadataParent"), 0 }
+        };
+
+        int32 NumClasses;
+        TestNotNull(TEXT("Parent written before child is registered"), ClassMetadata::Register(WriteClasses(Classes), NumClasses));
+        TestEqual(TEXT("Both classes are registered"), NumClasses, 2);
+
+        ProcessNewlyLoadedUObjects();
+
+        auto Parent = ClassRegistry::FindClass(TEXT("UNETTestMetadataParent"));
+        auto Child = ClassRegistry::FindClass(TEXT("UNETTestMetadataChild"));
+
+        if (TestNotNull(TEXT("Parent class is created"), Parent) && TestNotNull(TEXT("Child class is created"), Child)) {
+            TestTrue(TEXT("Child class derives from parent in the same blob"), Child->IsChildOf(Parent));
+        }
+    }
+
+    AddExpectedError(TEXT("is declared twice"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("must be written before it"), EAutomationExpectedErrorFlags::Contains, 2);
+
+    {
+        const FTestClassRecord Classes[] = {
+            { TEXT("UNETTestMetadataDuplicate"), TEXT("Object"), INDEX_NONE },
+            { TEXT("UNETTestMetadataDuplicate"), TEXT("Object"), INDEX_NONE }
+        };
+
+        TestFalse(TEXT("Blob with duplicate class is rejected"), IsRegistered(WriteClasses(Classes)));
+    }
+
+    {
+        const FTestClassRecord Classes[] = {
+            { TEXT("UNETTestMetadataEarlyChild"), TEXT("UNETTestMetadataLateParent"), 1 },
+            { TEXT("UNETTestMetadataLateParent"), TEXT("Object"), INDEX_NONE }
+        };
+
+        TestFalse(TEXT("Blob with child before parent is rejected"), IsRegistered(WriteClasses(Classes)));
+    }
+
+    {
+        const FTestClassRecord Classes[] = {
+            { TEXT("UNETTestMetadataOwnParent"), TEXT("UNETTestMetadataOwnParent"), 0 }
+        };
+
+        TestFalse(TEXT("Class that is its own parent is rejected"), IsRegistered(WriteClasses(Classes)));
+    }
+
+    TestNull(TEXT("Nothing is registered from rejected blobs"), ClassRegistry::FindClass(TEXT("UNETTestMetadataEarlyChild")));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETClassMetadataRejectionTest, "UNET.ClassMetadata.Rejection",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETClassMetadataRejectionTest::RunTest(const FString& Parameters) {
+    AddExpectedError(TEXT("has unknown format"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("is not supported"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("is truncated"), EAutomationExpectedErrorFlags::Contains, 2);
+    AddExpectedError(TEXT("has invalid names"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("has invalid layout"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("of managed class UNETTestRejectedObject is invalid"), EAutomationExpectedErrorFlags::Contains, 1);
+
+    {
+        auto Blob = WriteRejectedClass();
+        GetHeader(Blob).Magic = 0;
+
+        TestFalse(TEXT("Blob of unknown format is rejected"), IsRegistered(MoveTemp(Blob)));
+    }
+
+    {
+        auto Blob = WriteRejectedClass();
+        GetHeader(Blob).Version = FClassMetadataHeader::CurrentVersion + 1;
+
+        TestFalse(TEXT("Blob of newer version is rejected"), IsRegistered(MoveTemp(Blob)));
+    }
+
+    {
+        auto Blob = WriteRejectedClass();
+        Blob.SetNum(GetHeader(Blob).StringsOffset);
+
+        TestFalse(TEXT("Blob without its strings is rejected"), IsRegistered(MoveTemp(Blob)));
+    }
+
+    {
+        auto Blob = WriteRejectedClass();
+        GetHeader(Blob).ClassesOffset = Blob.Num();
+
+        TestFalse(TEXT("Blob with classes past its end is rejected"), IsRegistered(MoveTemp(Blob)));
+    }
+
+    {
+        auto Blob = WriteRejectedClass();
+        GetClass(Blob, 0).ClassName = GetHeader(Blob).StringsSize;
+
+        TestFalse(TEXT("Class with name out of string pool is rejected"), IsRegistered(MoveTemp(Blob)));
+    }
+
+    {
+        auto Blob = WriteRejectedClass();
+        GetClass(Blob, 0).FirstProperty = 1;
+
+        TestFalse(TEXT("Class with properties out of blob is rejected"), IsRegistered(MoveTemp(Blob)));
+    }
+
+    {
+        auto Blob = WriteRejectedClass();
+        ((FPropertyMetadataRecord*)(Blob.GetData() + GetHeader(Blob).PropertiesOffset))->Offset = 2;
+
+        TestFalse(TEXT("Misaligned property is rejected"), IsRegistered(MoveTemp(Blob)));
+    }
+
+    TestNull(TEXT("Nothing is registered from rejected blobs"), ClassRegistry::FindClass(TEXT("UNETTestRejectedObject")));
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,292 @@
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <Kismet/KismetMathLibrary.h>
+#include <UObject/Package.h>
+#include <UObject/UnrealType.h>
+
+#include "Delegates.h"
+#include "UNETTestClasses.h"
+
+namespace {
+
+    using namespace UNET;
+
+    // Writes commands the same way as C# CommandBuffer does, so buffers can be executed without managed runtime
+    class FTestCommandBuffer {
+
+        TArray<uint8> Data;
+        TArray<int32> ObjectOffsets;
+
+    public:
+
+        FTestCommandBuffer() {
+            // Commands are filled in place, so buffer must not move while test writes them
+            Data.Reserve(4096);
+        }
+
+        template<typename TCommand>
+        TCommand* Add(EManagedCommand Type, int32 TrailingSize = 0) {
+            auto Size = Align((int32)(sizeof(FManagedCommandHeader) + sizeof(TCommand)) + TrailingSize, FManagedCommandHeader::CommandAlignment);
+            auto Header = (FManagedCommandHeader*)(Data.GetData() + Data.AddZeroed(Size));
+
+            Header->Type = Type;
+            Header->Size = Size;
+
+            return (TCommand*)(Header + 1);
+        }
+
+        // Object is recorded as pointer, it is turned into reference by ExecuteCommands
+        void SetObject(FManagedObjectRef& Field, UObject* Object) {
+            *(UObject**)&Field = Object;
+            AddObjectOffset((int32)((uint8*)&Field - Data.GetData()));
+        }
+
+        void AddObjectOffset(int32 Offset) {
+            ObjectOffsets.Add(Offset);
+        }
+
+        FManagedCommandHeader* GetHeader(const void* Command) {
+            return (FManagedCommandHeader*)Command - 1;
+        }
+
+        int32 Execute() {
+            return ExecuteCommands(Data.GetData(), Data.Num(), ObjectOffsets.GetData(), ObjectOffsets.Num(), nullptr, 0);
+        }
+    };
+
+    UClass* RegisterTargetClass() {
+        const Tests::FTestProperty Properties[] = {
+            { "Value", UECodeGen_Private::EPropertyGenFlags::Int, 0 },
+            { "Reference", UECodeGen_Private::EPropertyGenFlags::Object, 8 }
+        };
+
+        return Tests::RegisterTestClass(TEXT("UNETTestCommandTarget"), TEXT("Object"), Properties);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETCommandBufferSetPropertyTest, "UNET.CommandBuffer.SetProperty",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETCommandBufferSetPropertyTest::RunTest(const FString& Parameters) {
+    auto Class = RegisterTargetClass();
+
+    if (!TestNotNull(TEXT("Managed class is registered"), Class)) {
+        return false;
+    }
+
+    auto ValueProperty = FindFProperty<FIntProperty>(Class, TEXT("Value"));
+    auto ReferenceProperty = FindFProperty<FObjectProperty>(Class, TEXT("Reference"));
+
+    if (!TestNotNull(TEXT("Value property is created"), ValueProperty) || !TestNotNull(TEXT("Reference property is created"), ReferenceProperty)) {
+        return false;
+    }
+
+    auto Target = NewObject<UObject>(GetTransientPackage(), Class);
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedSetPropertyCommand>(EManagedCommand::SetProperty, sizeof(int32));
+        Buffer.SetObject(Command->Target, Target);
+        Command->Offset = ValueProperty->GetOffset_ForInternal();
+        Command->Size = sizeof(int32);
+        Command->RepIndex = INDEX_NONE;
+        *(int32*)(Command + 1) = 42;
+
+        TestEqual(TEXT("Write to plain old data property is executed"), Buffer.Execute(), 1);
+        TestEqual(TEXT("Property has written value"), ValueProperty->GetPropertyValue_InContainer(Target), 42);
+    }
+
+    AddExpectedError(TEXT("isn't plain old data property"), EAutomationExpectedErrorFlags::Contains, 2);
+    AddExpectedError(TEXT("commands of managed command buffer are skipped"), EAutomationExpectedErrorFlags::Contains, 2);
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedSetPropertyCommand>(EManagedCommand::SetProperty, sizeof(UObject*));
+        Buffer.SetObject(Command->Target, Target);
+        Command->Offset = 0;
+        Command->Size = sizeof(UObject*);
+        Command->RepIndex = INDEX_NONE;
+
+        TestEqual(TEXT("Write over object header is rejected"), Buffer.Execute(), 0);
+    }
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedSetPropertyCommand>(EManagedCommand::SetProperty, sizeof(UObject*));
+        Buffer.SetObject(Command->Target, Target);
+        Command->Offset = ReferenceProperty->GetOffset_ForInternal();
+        Command->Size = sizeof(UObject*);
+        Command->RepIndex = INDEX_NONE;
+        *(UObject**)(Command + 1) = Target;
+
+        TestEqual(TEXT("Write to object property is rejected"), Buffer.Execute(), 0);
+        TestNull(TEXT("Object property is not changed"), ReferenceProperty->GetObjectPropertyValue_InContainer(Target));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETCommandBufferCallFunctionTest, "UNET.CommandBuffer.CallFunction",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETCommandBufferCallFunctionTest::RunTest(const FString& Parameters) {
+    struct FAddParams {
+        int32 A;
+        int32 B;
+        int32 ReturnValue;
+    };
+
+    auto Target = GetMutableDefault<UKismetMathLibrary>();
+    auto Function = Target->FindFunction(TEXT("Add_IntInt"));
+
+    if (!TestNotNull(TEXT("Function is found"), Function) || !TestEqual(TEXT("Frame matches function"), (int32)Function->ParmsSize, (int32)sizeof(FAddParams))) {
+        return false;
+    }
+
+    auto AddCall = [&](FTestCommandBuffer& Buffer, int32 ParamsSize) {
+        auto ParamsOffset = (int32)(sizeof(FManagedCommandHeader) + sizeof(FManagedCallFunctionCommand));
+        auto Command = Buffer.Add<FManagedCallFunctionCommand>(EManagedCommand::CallFunction, ParamsSize);
+        Buffer.SetObject(Command->Target, Target);
+        Buffer.SetObject(Command->Function, Function);
+        Command->ParamsOffset = ParamsOffset;
+        Command->ParamsSize = ParamsSize;
+
+        return (FAddParams*)((uint8*)Buffer.GetHeader(Command) + ParamsOffset);
+    };
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Params = AddCall(Buffer, sizeof(FAddParams));
+        Params->A = 2;
+        Params->B = 3;
+
+        TestEqual(TEXT("Call with matching frame is executed"), Buffer.Execute(), 1);
+        TestEqual(TEXT("Function writes return value to frame"), Params->ReturnValue, 5);
+    }
+
+    AddExpectedError(TEXT("doesn't match"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("commands of managed command buffer are skipped"), EAutomationExpectedErrorFlags::Contains, 1);
+
+    {
+        FTestCommandBuffer Buffer;
+        AddCall(Buffer, sizeof(int32));
+
+        TestEqual(TEXT("Call with frame smaller than parameters is rejected"), Buffer.Execute(), 0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETCommandBufferMalformedTest, "UNET.CommandBuffer.Malformed",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETCommandBufferMalformedTest::RunTest(const FString& Parameters) {
+    auto Class = RegisterTargetClass();
+
+    if (!TestNotNull(TEXT("Managed class is registered"), Class)) {
+        return false;
+    }
+
+    auto Target = NewObject<UObject>(GetTransientPackage(), Class);
+
+    AddExpectedError(TEXT("is malformed"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("object at invalid offset"), EAutomationExpectedErrorFlags::Contains, 2);
+    AddExpectedError(TEXT("commands of managed command buffer are skipped"), EAutomationExpectedErrorFlags::Contains, 2);
+
+    {
+        FTestCommandBuffer Buffer;
+        Buffer.Add<FManagedDestroyActorCommand>(EManagedCommand::DestroyActor);
+        auto Command = Buffer.Add<FManagedMarkPropertyDirtyCommand>(EManagedCommand::MarkPropertyDirty);
+        Buffer.SetObject(Command->Target, Target);
+
+        // Size that isn't multiple of alignment can't be written by managed side, so the rest of buffer isn't trusted
+        Buffer.GetHeader(Command)->Size -= 4;
+
+        TestEqual(TEXT("Commands after malformed one are not executed"), Buffer.Execute(), 0);
+    }
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedSetPropertyCommand>(EManagedCommand::SetProperty, sizeof(int32));
+        Buffer.SetObject(Command->Target, Target);
+        Command->Offset = FindFProperty<FIntProperty>(Class, TEXT("Value"))->GetOffset_ForInternal();
+        Command->Size = 64;
+
+        TestEqual(TEXT("Command shorter than its trailing data is skipped"), Buffer.Execute(), 0);
+    }
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedMarkPropertyDirtyCommand>(EManagedCommand::MarkPropertyDirty);
+        Buffer.SetObject(Command->Target, Target);
+        Buffer.AddObjectOffset(4096);
+
+        TestEqual(TEXT("Buffer with object out of its bounds is not executed"), Buffer.Execute(), 0);
+    }
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedMarkPropertyDirtyCommand>(EManagedCommand::MarkPropertyDirty);
+        Buffer.SetObject(Command->Target, Target);
+        Buffer.AddObjectOffset(sizeof(FManagedCommandHeader) + 4);
+
+        TestEqual(TEXT("Buffer with misaligned object is not executed"), Buffer.Execute(), 0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETCommandBufferStaleObjectTest, "UNET.CommandBuffer.StaleObject",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETCommandBufferStaleObjectTest::RunTest(const FString& Parameters) {
+    auto Class = RegisterTargetClass();
+
+    if (!TestNotNull(TEXT("Managed class is registered"), Class)) {
+        return false;
+    }
+
+    auto ValueProperty = FindFProperty<FIntProperty>(Class, TEXT("Value"));
+    auto Target = NewObject<UObject>(GetTransientPackage(), Class);
+
+    AddExpectedError(TEXT("commands of managed command buffer are skipped"), EAutomationExpectedErrorFlags::Contains, 2);
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedSetPropertyCommand>(EManagedCommand::SetProperty, sizeof(int32));
+
+        // Reference of object which slot was reused since it was made, the same as FWeakObjectPtr of destroyed object
+        Command->Target = FManagedObjectRef::Make(Target);
+        Command->Target.SerialNumber++;
+        Command->Offset = ValueProperty->GetOffset_ForInternal();
+        Command->Size = sizeof(int32);
+        Command->RepIndex = INDEX_NONE;
+        *(int32*)(Command + 1) = 7;
+
+        TestEqual(TEXT("Command of stale reference is skipped"), Buffer.Execute(), 0);
+        TestEqual(TEXT("Object is not written through stale reference"), ValueProperty->GetPropertyValue_InContainer(Target), 0);
+    }
+
+    {
+        FTestCommandBuffer Buffer;
+        auto Command = Buffer.Add<FManagedSetPropertyCommand>(EManagedCommand::SetProperty, sizeof(int32));
+        Buffer.SetObject(Command->Target, Target);
+        Command->Offset = ValueProperty->GetOffset_ForInternal();
+        Command->Size = sizeof(int32);
+        Command->RepIndex = INDEX_NONE;
+        *(int32*)(Command + 1) = 7;
+
+        // Object is destroyed after it was recorded, but before buffer is submitted
+        Target->MarkAsGarbage();
+
+        TestEqual(TEXT("Command of destroyed object is skipped"), Buffer.Execute(), 0);
+        TestEqual(TEXT("Destroyed object is not written"), ValueProperty->GetPropertyValue_InContainer(Target), 0);
+    }
+
+    return true;
+}
+
+#endif
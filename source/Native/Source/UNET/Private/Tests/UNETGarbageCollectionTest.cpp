@@ -0,0 +1,51 @@
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <UObject/Package.h>
+#include <UObject/UnrealType.h>
+
+#include "UNETTestClasses.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETManagedReferenceGCTest, "UNET.GarbageCollection.ManagedObjectReference",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETManagedReferenceGCTest::RunTest(const FString& Parameters) {
+    const UNET::Tests::FTestProperty Properties[] = {
+        { "Reference", UECodeGen_Private::EPropertyGenFlags::Object, 0 }
+    };
+
+    auto Class = UNET::Tests::RegisterTestClass(TEXT("UNETTestReferencingObject"), TEXT("Object"), Properties);
+
+    if (!TestNotNull(TEXT("Managed class is registered"), Class)) {
+        return false;
+    }
+
+    auto Property = FindFProperty<FObjectProperty>(Class, TEXT("Reference"));
+
+    if (!TestNotNull(TEXT("Managed object property is created"), Property)) {
+        return false;
+    }
+
+    auto Owner = NewObject<UObject>(GetTransientPackage(), Class);
+    Owner->AddToRoot();
+
+    // Referenced object is reachable only through managed property of rooted owner
+    TWeakObjectPtr<UObject> Referenced = NewObject<UObject>(GetTransientPackage(), Class);
+    TWeakObjectPtr<UObject> Unreferenced = NewObject<UObject>(GetTransientPackage(), Class);
+
+    Property->SetObjectPropertyValue_InContainer(Owner, Referenced.Get());
+
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+    TestTrue(TEXT("Object referenced only from managed property survives GC"), Referenced.IsValid());
+    TestFalse(TEXT("Unreferenced object is collected, so GC has run"), Unreferenced.IsValid());
+    TestEqual(TEXT("Managed property still points to referenced object"), Property->GetObjectPropertyValue_InContainer(Owner), Referenced.Get());
+
+    Owner->RemoveFromRoot();
+
+    return true;
+}
+
+#endif
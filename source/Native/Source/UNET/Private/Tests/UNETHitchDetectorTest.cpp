@@ -0,0 +1,78 @@
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "UNETHitchDetector.h"
+#include "UNETSettings.h"
+
+namespace {
+
+    // Keeps report lines, so test can check what would be printed to console
+    class FReportOutput : public FOutputDevice {
+
+    public:
+
+        FString Text;
+
+        virtual void Serialize(const TCHAR* Line, ELogVerbosity::Type Verbosity, const FName& Category) override {
+            Text += Line;
+            Text += TEXT("\n");
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETHitchDetectorTest, "UNET.HitchDetector.SlowCall",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETHitchDetectorTest::RunTest(const FString& Parameters) {
+    FReportOutput InitialSummary;
+    UNET::ReportHitchSummary(InitialSummary);
+
+    auto bWasRunning = !InitialSummary.Text.Contains(TEXT("is not running"));
+
+    // Detector is restarted, so the hitch below is the only one in its history
+    UNET::StartHitchDetector(1.0f);
+
+    AddExpectedError(TEXT("Game thread is in managed code"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("spent in managed code"), EAutomationExpectedErrorFlags::Contains, 1);
+
+    {
+        static const FName CallName = TEXT("UNETTestSlowCall");
+        UNET::FManagedCallScope CallScope(CallName);
+
+        // Watchdog checks calls every half of threshold, so it sees this one while it is still running
+        FPlatformProcess::Sleep(0.05f);
+    }
+
+    auto StartFrame = GFrameCounter;
+
+    // Hitch is recorded when frame ends, so summary is checked in one of the next frames
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, StartFrame, bWasRunning]() {
+        if (GFrameCounter < StartFrame + 2) {
+            return false;
+        }
+
+        FReportOutput Summary;
+        UNET::ReportHitchSummary(Summary);
+
+        TestTrue(TEXT("Hitch is recorded"), Summary.Text.Contains(TEXT("Managed hitches: 1 since start")));
+        TestTrue(TEXT("Slow call is reported"), Summary.Text.Contains(TEXT("UNETTestSlowCall")));
+        TestTrue(TEXT("Call is reported by watchdog while it is running"), Summary.Text.Contains(TEXT("stuck in UNETTestSlowCall")));
+
+        auto ThresholdMs = GetDefault<UUNETSettings>()->ManagedHitchThresholdMs;
+
+        if (bWasRunning && ThresholdMs > 0.0f) {
+            UNET::StartHitchDetector(ThresholdMs);
+        }
+        else {
+            UNET::StopHitchDetector();
+        }
+
+        return true;
+    }));
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <Engine/Engine.h>
+#include <Engine/NetConnection.h>
+#include <Engine/NetDriver.h>
+#include <Engine/PendingNetGame.h>
+#include <EngineUtils.h>
+#include <GameFramework/GameModeBase.h>
+#include <UObject/UnrealType.h>
+
+#include "UNETReplicationTestActor.h"
+#include "UNETTestClasses.h"
+
+namespace {
+
+    constexpr float FrameSeconds = 1.0f / 60.0f;
+    constexpr int32 MaxFrames = 600;
+
+    UWorld* CreateGameWorld(bool bIsServer) {
+        auto World = UWorld::CreateWorld(EWorldType::Game, false);
+        GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+
+        FURL URL;
+
+        if (bIsServer) {
+            World->SetGameMode(URL);
+
+            // Player controller is enough for the connection to receive actors
+            World->GetAuthGameMode()->DefaultPawnClass = nullptr;
+        }
+
+        World->InitializeActorsForPlay(URL);
+        World->BeginPlay();
+
+        return World;
+    }
+
+    void DestroyGameWorld(UWorld* World) {
+        GEngine->ShutdownWorldNetDriver(World);
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    // Ticks both sides until condition is met, net drivers send and receive packets in world ticks
+    bool TickUntil(UWorld* Server, FWorldContext& ClientContext, TFunctionRef<bool()> Condition) {
+        for (int32 Frame = 0; Frame < MaxFrames; Frame++) {
+            if (Condition()) {
+                return true;
+            }
+
+            Server->Tick(LEVELTICK_All, FrameSeconds);
+
+            if (ClientContext.PendingNetGame) {
+                ClientContext.PendingNetGame->Tick(FrameSeconds);
+            }
+            else {
+                ClientContext.World()->Tick(LEVELTICK_All, FrameSeconds);
+            }
+
+            FPlatformProcess::Sleep(0.001f);
+        }
+
+        return Condition();
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUNETManagedPropertyReplicationTest, "UNET.Replication.ManagedPropertyRepNotify",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUNETManagedPropertyReplicationTest::RunTest(const FString& Parameters) {
+    const UNET::Tests::FTestProperty Properties[] = {
+        { "Value", UECodeGen_Private::EPropertyGenFlags::Int, 0, CPF_Net, "OnRep_Value" }
+    };
+
+    auto Class = UNET::Tests::RegisterTestClass(TEXT("UNETTestReplicatedActor"), TEXT("UNETReplicationTestActor"), Properties);
+
+    if (!TestNotNull(TEXT("Managed class is registered"), Class)) {
+        return false;
+    }
+
+    auto Property = FindFProperty<FIntProperty>(Class, TEXT("Value"));
+
+    if (!TestNotNull(TEXT("Managed property is created"), Property) ||
+        !TestTrue(TEXT("Managed property is replicated with RepNotify"), Property->HasAllPropertyFlags(CPF_Net | CPF_RepNotify))) {
+        return false;
+    }
+
+    auto Server = CreateGameWorld(true);
+
+    FURL ListenURL;
+    ListenURL.Port = 0;
+
+    if (!TestTrue(TEXT("Server listens on loopback"), Server->Listen(ListenURL))) {
+        DestroyGameWorld(Server);
+        return false;
+    }
+
+    auto Client = CreateGameWorld(false);
+    auto& ClientContext = GEngine->GetWorldContextFromWorldChecked(Client);
+
+    // The same steps as engine makes on travel to server, but into already created world
+    auto PendingNetGame = NewObject<UPendingNetGame>();
+    PendingNetGame->Initialize(FURL(nullptr, *FString::Printf(TEXT("127.0.0.1:%d"), ListenURL.Port), TRAVEL_Absolute));
+    PendingNetGame->InitNetDriver();
+    ClientContext.PendingNetGame = PendingNetGame;
+
+    auto bIsConnected = TickUntil(Server, ClientContext, [PendingNetGame]() {
+        return PendingNetGame->bSuccessfullyConnected || !PendingNetGame->ConnectionError.IsEmpty();
+    }) && PendingNetGame->bSuccessfullyConnected;
+
+    if (!TestTrue(TEXT("Client connects to server"), bIsConnected)) {
+        AddError(PendingNetGame->ConnectionError);
+
+        if (PendingNetGame->NetDriver) {
+            GEngine->DestroyNamedNetDriver(PendingNetGame, PendingNetGame->NetDriver->NetDriverName);
+        }
+
+        ClientContext.PendingNetGame = nullptr;
+        DestroyGameWorld(Client);
+        DestroyGameWorld(Server);
+        return false;
+    }
+
+    GEngine->MovePendingLevel(ClientContext);
+    PendingNetGame->TravelCompleted(GEngine, ClientContext);
+    ClientContext.PendingNetGame = nullptr;
+
+    auto ServerActor = Server->SpawnActor<AUNETReplicationTestActor>(Class);
+
+    if (TestNotNull(TEXT("Managed actor is spawned on server"), ServerActor)) {
+        Property->SetPropertyValue_InContainer(ServerActor, 42);
+
+        AUNETReplicationTestActor* ClientActor = nullptr;
+
+        TickUntil(Server, ClientContext, [&]() {
+            for (TActorIterator<AUNETReplicationTestActor> It(Client, Class); It; ++It) {
+                ClientActor = *It;
+            }
+
+            return ClientActor && ClientActor->NumValueNotifies > 0;
+        });
+
+        if (TestNotNull(TEXT("Managed actor is replicated to client"), ClientActor)) {
+            TestEqual(TEXT("Managed property has server value on client"), Property->GetPropertyValue_InContainer(ClientActor), 42);
+            TestEqual(TEXT("RepNotify of managed property is called once"), ClientActor->NumValueNotifies, 1);
+        }
+    }
+
+    DestroyGameWorld(Client);
+    DestroyGameWorld(Server);
+
+    return true;
+}
+
+#endif
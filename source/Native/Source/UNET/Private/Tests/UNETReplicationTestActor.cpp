@@ -0,0 +1,10 @@
+#include "UNETReplicationTestActor.h"
+
+AUNETReplicationTestActor::AUNETReplicationTestActor() {
+    bReplicates = true;
+    bAlwaysRelevant = true;
+}
+
+void AUNETReplicationTestActor::OnRep_Value() {
+    NumValueNotifies++;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "UNETActor.h"
+
+#include "UNETReplicationTestActor.generated.h"
+
+/**
+ *   Native parent of managed class in replication test, it declares RepNotify function that managed metadata refers to by name.
+ */
+UCLASS(Transient, NotPlaceable, NotBlueprintable)
+class AUNETReplicationTestActor : public AUNETActor {
+    GENERATED_BODY()
+
+public:
+    AUNETReplicationTestActor();
+
+    // Count of OnRep_Value calls on this instance
+    int32 NumValueNotifies = 0;
+
+    UFUNCTION()
+    void OnRep_Value();
+};
@@ -0,0 +1,20 @@
+#include "UNETTestClasses.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClassRegistry.h"
+
+UClass* UNET::Tests::RegisterTestClass(const TCHAR* ClassName, const TCHAR* ParentName, TArrayView<const FTestProperty> Properties) {
+    int32 NumClasses;
+
+    if (!ClassMetadata::Register(ClassMetadata::Write(TEXT("/Script/UNETTests"), ClassName, ParentName, Properties), NumClasses)) {
+        return nullptr;
+    }
+
+    // The same way as after plugins are loaded, registered classes are constructed on request
+    ProcessNewlyLoadedUObjects();
+
+    return ClassRegistry::FindClass(ClassName);
+}
+
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClassMetadata.h"
+
+namespace UNET::Tests {
+
+    using FTestProperty = ClassMetadata::FPropertyDeclaration;
+
+    // Registers managed class from precompiled metadata written by test, so classes can be tested without managed runtime.
+    // Class with the same layout is reused when test runs again, returns nullptr when class can't be registered
+    UClass* RegisterTestClass(const TCHAR* ClassName, const TCHAR* ParentName, TArrayView<const FTestProperty> Properties);
+}
+
+#endif
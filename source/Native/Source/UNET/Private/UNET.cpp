@@ -1,5 +1,14 @@
 #include "UNET.h"
 
+#include <UObject/UObjectBase.h>
+#include <UObject/Package.h>
+#include <UObject/StrongObjectPtr.h>
+#include <Misc/FileHelper.h>
+#include <Misc/CoreDelegates.h>
+
+#include "ClassRegistry.h"
+#include "UNETDelegateHandler.h"
+
 #define LOCTEXT_NAMESPACE "FUNETModule"
 
 DEFINE_LOG_CATEGORY(LogUNET);
@@ -24,15 +33,39 @@ FUNETModule::FUNETModule() :
     ReloadManagedPluginsCommand(
         TEXT("UNET.ReloadManagedPlugins"),
         TEXT("Reload UNET Plugins"),
-        FConsoleCommandDelegate::CreateRaw(this, &FUNETModule::ReloadPlugins))
+        FConsoleCommandDelegate::CreateRaw(this, &FUNETModule::ReloadPlugins)),
+    MemReportCommand(
+        TEXT("UNET.MemReport"),
+        TEXT("Report managed heap and UNET Plugins memory usage"),
+        FConsoleCommandWithOutputDeviceDelegate::CreateRaw(this, &FUNETModule::ReportMemory)),
+    HitchSummaryCommand(
+        TEXT("UNET.HitchSummary"),
+        TEXT("Report recent frames that spent longer than hitch threshold in managed code"),
+        FConsoleCommandWithOutputDeviceDelegate::CreateRaw(this, &FUNETModule::ReportHitches)),
+    BenchmarkCommand(
+        TEXT("UNET.Benchmark"),
+        TEXT("Measure UNET interop paths and write results to Saved/UNET/Benchmark.json. Arguments: [Iterations]"),
+        FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(this, &FUNETModule::Benchmark)),
+    LoadClassCommand(
+        TEXT("UNET.LoadClass"),
+        TEXT("Load managed class and plugin that declares it, if plugin is loaded on demand. Arguments: ClassName"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUNETModule::LoadClass))
 { }
 
 void FUNETModule::StartupModule() {
+    // Managed scratch buffers are recycled at the end of every frame
+    UNET::InitializeFrameArena(GetDefault<UUNETSettings>()->FrameArenaSizeKB * 1024ll);
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&UNET::ResetFrameArena);
+
     LoadRuntime();
 }
 
 void FUNETModule::ShutdownModule() {
     UnloadRuntime();
+    Runtime.Shutdown(Host);
+
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    UNET::ReleaseFrameArena();
 }
 
 void FUNETModule::LoadPlugins() {
@@ -41,7 +74,46 @@ void FUNETModule::LoadPlugins() {
         return;
     }
 
-    UNET::PluginLoaderDelegates.Load();
+    {
+        static const FName CallName = TEXT("LoadPlugins");
+        UNET::FManagedCallScope CallScope(CallName);
+
+        UNET::PluginLoaderDelegates.Load();
+    }
+
+    // Classes registered after engine startup are not constructed until someone asks UE to process them
+    ProcessNewlyLoadedUObjects();
+
+    if (UNET::ClassRegistry::NumDeferred() > 0) {
+        UE_LOG(LogUNET, Log, TEXT("%d managed classes wait for their plugins to be loaded on demand"), UNET::ClassRegistry::NumDeferred());
+    }
+}
+
+UClass* FUNETModule::FindOrLoadClass(FName ClassName) {
+    if (!Runtime.IsActive()) {
+        UE_LOG(LogUNET, Error, TEXT("UNET Runtime is not loaded"));
+        return nullptr;
+    }
+
+    auto Class = UNET::ClassRegistry::LoadDeferredClass(ClassName);
+
+    // Classes of plugin loaded on demand are constructed the same way as after LoadPlugins
+    if (Class) {
+        ProcessNewlyLoadedUObjects();
+    }
+
+    return Class;
+}
+
+void FUNETModule::LoadClass(const TArray<FString>& Args) {
+    if (Args.Num() == 0) {
+        UE_LOG(LogUNET, Error, TEXT("Class name is expected"));
+        return;
+    }
+
+    if (!FindOrLoadClass(*Args[0])) {
+        UE_LOG(LogUNET, Error, TEXT("Managed class %s is not found"), *Args[0]);
+    }
 }
 
 void FUNETModule::ReloadPlugins() {
@@ -50,7 +122,8 @@ void FUNETModule::ReloadPlugins() {
         return;
     }
 
-    UNET::PluginLoaderDelegates.Reload();
+    UnloadPlugins();
+    LoadPlugins();
 }
 
 void FUNETModule::UnloadPlugins() {
@@ -59,23 +132,157 @@ void FUNETModule::UnloadPlugins() {
         return;
     }
 
+    // Handlers point to code of plugins, so they must not be called after this point
+    UUNETDelegateHandler::UnbindAll();
+
     UNET::PluginLoaderDelegates.Unload();
+    UNET::ClassRegistry::Reset();
+}
+
+void FUNETModule::ReportMemory(FOutputDevice& Ar) {
+    if (!Runtime.IsActive()) {
+        Ar.Logf(TEXT("UNET Runtime is not loaded"));
+        return;
+    }
+
+    UNET::ReportManagedMemory(Ar);
+}
+
+void FUNETModule::ReportHitches(FOutputDevice& Ar) {
+    UNET::ReportHitchSummary(Ar);
+}
+
+bool FUNETModule::UpdateMemoryStats(float DeltaTime) {
+    if (Runtime.IsActive()) {
+        UNET::UpdateManagedMemoryStats();
+    }
+
+    return true;
+}
+
+bool FUNETModule::ProcessPendingReloads(float DeltaTime) {
+    if (!Runtime.IsActive() || UNET::PluginLoaderDelegates.GetPendingReloads() == 0) {
+        return true;
+    }
+
+    int32 NumReloaded;
+
+    // Delegate handlers of each pending plugin are unbound by loader right before that plugin is reloaded
+    {
+        static const FName CallName = TEXT("ReloadPending");
+        UNET::FManagedCallScope CallScope(CallName);
+
+        NumReloaded = UNET::PluginLoaderDelegates.ReloadPending();
+    }
+
+    // Construction of classes is native work, so it is not counted as time of managed call
+    if (NumReloaded > 0) {
+        ProcessNewlyLoadedUObjects();
+    }
+
+    return true;
+}
+
+bool FUNETModule::UpdateTraceSession(float DeltaTime) {
+    auto Events = GetDefault<UUNETSettings>()->ManagedTraceEvents;
+    auto bShouldTrace = Runtime.IsActive() && Events != 0 && UNET::IsManagedTraceEnabled();
+
+    if (bShouldTrace && !bIsTraceSessionActive) {
+        UNET::PluginLoaderDelegates.StartTraceSession(Events);
+        bIsTraceSessionActive = true;
+    }
+    else if (!bShouldTrace) {
+        StopTraceSession();
+    }
+
+    return true;
+}
+
+void FUNETModule::StopTraceSession() {
+    if (bIsTraceSessionActive) {
+        UNET::PluginLoaderDelegates.StopTraceSession();
+        bIsTraceSessionActive = false;
+    }
+}
+
+void FUNETModule::Benchmark(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) {
+    auto Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : DefaultBenchmarkIterations;
+
+    UNET::Benchmark Benchmark;
+
+    if (!RunBenchmarks(Iterations, Benchmark)) {
+        Ar.Logf(TEXT("UNET Runtime is not loaded"));
+        return;
+    }
+
+    Benchmark.Print(Ar);
+
+    auto OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UNET"), TEXT("Benchmark.json"));
+    FFileHelper::SaveStringToFile(Benchmark.ToJson(), *OutputPath);
 }
 
-FORCENOINLINE bool FUNETModule::LoadHost() {
+bool FUNETModule::RunBenchmarks(int32 Iterations, UNET::Benchmark& Benchmark) {
+    if (!Runtime.IsActive()) {
+        UE_LOG(LogUNET, Error, TEXT("UNET Runtime is not loaded"));
+        return false;
+    }
+
+    using UNET::EManagedBenchmark;
+
+    Benchmark.Add(TEXT("RuntimeColdStart"), 1, ColdStartSeconds);
+
+    if (UNET::ClassRegistry::GetNumRegistrations() > 0) {
+        Benchmark.Add(TEXT("ClassRegistration"), UNET::ClassRegistry::GetNumRegistrations(), UNET::ClassRegistry::GetRegistrationSeconds());
+    }
+
+    Benchmark.Measure(TEXT("NativeToManagedCall"), Iterations, [&] {
+        for (int32 i = 0; i < Iterations; i++) {
+            UNET::PluginLoaderDelegates.Ping();
+        }
+    });
+
+    Benchmark.Add(TEXT("ManagedToNativeCall"), Iterations,
+        UNET::PluginLoaderDelegates.RunBenchmark(EManagedBenchmark::ManagedToNativeCall, Iterations, nullptr, 0));
+
+    Benchmark.Add(TEXT("DebugLogRoundTrip"), Iterations,
+        UNET::PluginLoaderDelegates.RunBenchmark(EManagedBenchmark::LogRoundTrip, Iterations, nullptr, 0));
+
+    // Managed side finds instances by QueryInstances and accesses their properties through returned property bases
+    if (auto PropertyClass = UNET::Benchmark::GetPropertyClass()) {
+        TArray<TStrongObjectPtr<UObject>> Instances;
+
+        for (int32 i = 0; i < UNET::Benchmark::NumPropertyClassInstances; i++) {
+            Instances.Emplace(NewObject<UObject>(GetTransientPackage(), PropertyClass));
+        }
+
+        Benchmark.Add(TEXT("PropertyReadWrite"), Iterations * UNET::Benchmark::NumPropertyClassProperties,
+            UNET::PluginLoaderDelegates.RunBenchmark(EManagedBenchmark::PropertyReadWrite, Iterations, PropertyClass, UNET::Benchmark::NumPropertyClassProperties));
+    }
+
+    Benchmark.Measure(TEXT("PluginsReload"), 1, [&] { ReloadPlugins(); });
+
+    Benchmark.Measure(TEXT("RuntimeReload"), 1, [&] {
+        UnloadRuntime();
+        LoadRuntime();
+    });
+
+    return Runtime.IsActive();
+}
+
+FORCENOINLINE bool FUNETModule::LoadHost(const FUNETRuntimePaths& Paths) {
     if (Host.IsActive()) {
         UE_LOG(LogUNET, Warning, TEXT("HostFXR is already loaded"));
         return true;
     }
 
-    auto Settings = GetDefault<UUNETSettings>();
-    if (!Settings->Validate()) {
+    Host.Load(Paths.HostfxrLibPath);
+
+    if (!Host.IsActive()) {
         UE_LOG(LogUNET, Error, TEXT("Failed to load HostFXR"));
         return false;
     }
 
-    Host.Load(Settings->GetHostfxrLibPath());
-    UE_LOG(LogUNET, Display, TEXT("HostFXR is loaded for .NET %s"), *Settings->DotNetVersion);
+    UE_LOG(LogUNET, Display, TEXT("HostFXR is loaded from %s"), *Paths.HostfxrLibPath);
     return true;
 }
 
@@ -85,21 +292,59 @@ void FUNETModule::LoadRuntime() {
         return;
     }
 
+    auto StartTime = FPlatformTime::Seconds();
+    auto bIsColdStart = !Runtime.IsInitialized();
+
     auto Settings = GetDefault<UUNETSettings>();
+    FUNETRuntimePaths Paths;
+
+    // CLR is alive after previous unload, so there is no need to look for .NET again
+    auto bUsesHostFXR = Settings->RuntimeBackend == EUNETRuntimeBackend::HostFXR;
 
-    if (!Settings->Validate() || !Host.IsActive() && !LoadHost()) {
+    if (bIsColdStart && (!Settings->Validate(Paths) || bUsesHostFXR && !Host.IsActive() && !LoadHost(Paths))) {
         return;
     }
 
-    Runtime.Load(Host, Settings);
+    Runtime.Load(Host, Settings, Paths);
 
     if (!Runtime.IsActive()) {
         UE_LOG(LogUNET, Error, TEXT("Failed to load UNET runtime"));
         return;
     }
 
-    UE_LOG(LogUNET, Display, TEXT("UNET Runtime is loaded"));
+    // CLR thread pool is sized from core count and competes with TaskGraph workers, so it can be capped
+    UNET::PluginLoaderDelegates.ConfigureThreadPool(Settings->ManagedThreadPoolMinThreads, Settings->ManagedThreadPoolMaxThreads);
+
     LoadPlugins();
+
+    // Started after plugins are loaded, so startup itself is not reported as a hitch
+    if (Settings->ManagedHitchThresholdMs > 0.0f) {
+        UNET::StartHitchDetector(Settings->ManagedHitchThresholdMs);
+    }
+
+    auto LoadSeconds = FPlatformTime::Seconds() - StartTime;
+
+    if (bIsColdStart) {
+        ColdStartSeconds = LoadSeconds;
+    }
+
+    UE_LOG(LogUNET, Display, TEXT("UNET Runtime is loaded in %.2f ms (%s, %s)"),
+        LoadSeconds * 1000.0,
+        bIsColdStart ? TEXT("cold start") : TEXT("logical reset"),
+        Runtime.IsNativeAOT() ? TEXT("NativeAOT") : TEXT("HostFXR"));
+
+    // Managed heap is not allocated via FMalloc, so LLM only sees it when we report it ourselves
+    MemoryStatsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FUNETModule::UpdateMemoryStats), 1.0f);
+
+    // Core ticker runs on game thread, so plugins are never swapped in the middle of a frame
+    HotReloadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FUNETModule::ProcessPendingReloads), 0.1f);
+
+    // Trace channels can be toggled at any moment, EventPipe session is kept only while someone listens
+    UpdateTraceSession(0.0f);
+    TraceSessionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FUNETModule::UpdateTraceSession), 1.0f);
 }
 
 void FUNETModule::UnloadRuntime() {
@@ -108,8 +353,25 @@ void FUNETModule::UnloadRuntime() {
         return;
     }
 
-    Runtime.Unload(Host);
-    UE_LOG(LogUNET, Display, TEXT("UNET Runtime is unloaded"));
+    auto StartTime = FPlatformTime::Seconds();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(MemoryStatsTickerHandle);
+    MemoryStatsTickerHandle.Reset();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(HotReloadTickerHandle);
+    HotReloadTickerHandle.Reset();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TraceSessionTickerHandle);
+    TraceSessionTickerHandle.Reset();
+    StopTraceSession();
+
+    // Watchdog queries runtime state, so it has to be stopped while runtime is alive
+    UNET::StopHitchDetector();
+
+    UnloadPlugins();
+    Runtime.Unload();
+
+    UE_LOG(LogUNET, Display, TEXT("UNET Runtime is unloaded in %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,8 @@
+#include "UNETActor.h"
+#include "UNETClass.h"
+
+void AUNETActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    UUNETClass::GetLifetimeReplicatedProps(GetClass(), OutLifetimeProps);
+}
@@ -0,0 +1,8 @@
+#include "UNETActorComponent.h"
+#include "UNETClass.h"
+
+void UUNETActorComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    UUNETClass::GetLifetimeReplicatedProps(GetClass(), OutLifetimeProps);
+}
@@ -0,0 +1,76 @@
+#include "UNETBenchmark.h"
+
+#include <Dom/JsonObject.h>
+#include <Serialization/JsonWriter.h>
+#include <Serialization/JsonSerializer.h>
+#include <Misc/EngineVersion.h>
+
+#include "ClassMetadata.h"
+#include "ClassRegistry.h"
+
+UClass* UNET::Benchmark::GetPropertyClass() {
+    static const TCHAR* ClassName = TEXT("UNETBenchmarkPropertyObject");
+
+    // Class outlives reloads of runtime, so it is declared only once
+    if (auto Class = ClassRegistry::FindClass(ClassName)) {
+        return Class;
+    }
+
+    // Names are copied to blob
+    ANSICHAR Names[NumPropertyClassProperties][16];
+    ClassMetadata::FPropertyDeclaration Properties[NumPropertyClassProperties];
+
+    for (int32 i = 0; i < NumPropertyClassProperties; i++) {
+        FCStringAnsi::Snprintf(Names[i], UE_ARRAY_COUNT(Names[i]), "Value%d", i);
+        Properties[i] = { Names[i], UECodeGen_Private::EPropertyGenFlags::Int, (uint32)(i * sizeof(int32)) };
+    }
+
+    int32 NumClasses;
+
+    if (!ClassMetadata::Register(ClassMetadata::Write(TEXT("/Script/UNETBenchmark"), ClassName, TEXT("Object"), Properties), NumClasses)) {
+        return nullptr;
+    }
+
+    ProcessNewlyLoadedUObjects();
+
+    return ClassRegistry::FindClass(ClassName);
+}
+
+FString UNET::Benchmark::ToJson() const {
+    auto Root = MakeShared<FJsonObject>();
+
+    Root->SetStringField(TEXT("Engine"), FEngineVersion::Current().ToString());
+    Root->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+    Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+
+    TArray<TSharedPtr<FJsonValue>> Entries;
+
+    for (auto& Result : Results) {
+        auto Entry = MakeShared<FJsonObject>();
+
+        Entry->SetStringField(TEXT("Name"), Result.Name);
+        Entry->SetNumberField(TEXT("Iterations"), Result.Iterations);
+        Entry->SetNumberField(TEXT("TotalMs"), Result.TotalSeconds * 1000.0);
+        Entry->SetNumberField(TEXT("PerIterationNs"), Result.GetNanosecondsPerIteration());
+
+        Entries.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    Root->SetArrayField(TEXT("Results"), Entries);
+
+    FString Output;
+    auto Writer = TJsonWriterFactory<>::Create(&Output);
+    FJsonSerializer::Serialize(Root, Writer);
+
+    return Output;
+}
+
+void UNET::Benchmark::Print(FOutputDevice& Ar) const {
+    for (auto& Result : Results) {
+        Ar.Logf(TEXT("  %-32s %8d x %12.3f ms %12.1f ns/iteration"),
+            *Result.Name,
+            Result.Iterations,
+            Result.TotalSeconds * 1000.0,
+            Result.GetNanosecondsPerIteration());
+    }
+}
@@ -0,0 +1,38 @@
+#include "UNETBenchmarkCommandlet.h"
+
+#include <Misc/FileHelper.h>
+
+#include "UNET.h"
+
+UUNETBenchmarkCommandlet::UUNETBenchmarkCommandlet() {
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UUNETBenchmarkCommandlet::Main(const FString& Params) {
+    int32 Iterations = FUNETModule::DefaultBenchmarkIterations;
+    FParse::Value(*Params, TEXT("iterations="), Iterations);
+
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UNET"), TEXT("Benchmark.json"));
+    FParse::Value(*Params, TEXT("output="), OutputPath);
+
+    auto& Module = FModuleManager::GetModuleChecked<FUNETModule>(TEXT("UNET"));
+
+    UNET::Benchmark Benchmark;
+
+    if (!Module.RunBenchmarks(Iterations, Benchmark)) {
+        return 1;
+    }
+
+    Benchmark.Print(*GLog);
+
+    if (!FFileHelper::SaveStringToFile(Benchmark.ToJson(), *OutputPath)) {
+        UE_LOG(LogUNET, Error, TEXT("Failed to write benchmark results to %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogUNET, Display, TEXT("Benchmark results are written to %s"), *OutputPath);
+    return 0;
+}
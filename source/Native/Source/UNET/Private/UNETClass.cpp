@@ -1,7 +1,71 @@
 #include "UNETClass.h"
 #include "Delegates.h"
+#include "ClassRegistry.h"
+#include "LogUNET.h"
+#include "UNETActor.h"
+#include "UNETActorComponent.h"
+#include "UNETCustomVersion.h"
+#include "UNETSettings.h"
 
-UUNETClass::UUNETClass(FManagedClassInfo* Info) :
+#include <Misc/ScopeExit.h>
+#include <Net/UnrealNetwork.h>
+#include <Serialization/CustomVersion.h>
+#include <UObject/ObjectSaveContext.h>
+#include <UObject/Package.h>
+
+/**
+* Forgets managed instances when they are destroyed
+*/
+class FManagedInstanceTracker : public FUObjectArray::FUObjectDeleteListener {
+
+public:
+
+    FManagedInstanceTracker() {
+        GUObjectArray.AddUObjectDeleteListener(this);
+    }
+
+    virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override {
+        // Index is valid until listeners return, unlike class of object
+        FScopeLock Lock(&UUNETClass::InstancesLock);
+        UUNETClass* Class;
+
+        if (UUNETClass::InstanceClasses.RemoveAndCopyValue(Index, Class)) {
+            Class->Instances.Remove((UObject*)Object);
+        }
+    }
+
+    virtual void OnUObjectArrayShutdown() override {
+        GUObjectArray.RemoveUObjectDeleteListener(this);
+    }
+};
+
+const FGuid FUNETCustomVersion::GUID(0x6A1E4D52, 0x3B7C4F0E, 0x9D215C8A, 0x47E0B613);
+
+static FCustomVersionRegistration GRegisterUNETCustomVersion(FUNETCustomVersion::GUID, FUNETCustomVersion::LatestVersion, TEXT("UNET"));
+
+namespace {
+
+    // "UNBP", written before each bulk block to catch misaligned reads
+    constexpr uint32 BulkPropertiesMagic = 0x50424E55;
+
+    enum class EManagedPropertiesFormat : uint8 {
+        Tagged,
+        Bulk
+    };
+
+    bool IsObjectPropertyType(FName Type) {
+        return Type == NAME_ObjectProperty || Type == NAME_ClassProperty;
+    }
+}
+
+FCriticalSection UUNETClass::InstancesLock;
+TMap<int32, UUNETClass*> UUNETClass::InstanceClasses;
+
+FCriticalSection UUNETClass::BulkLayoutsLock;
+TMap<uint32, TArray<UUNETClass::FBulkProperty>> UUNETClass::KnownBulkLayouts;
+TMap<TPair<const UPackage*, const UUNETClass*>, TWeakObjectPtr<UObject>> UUNETClass::SavedBulkLayoutOwners;
+
+UUNETClass::UUNETClass(FManagedClassInfo* Info, EManagedClassInfoVersion Version, const TArray<uint8>& OwnDefaultValues) :
     UClass(
         EC_StaticConstructor,
         Info->ClassName,
@@ -11,19 +75,598 @@ UUNETClass::UUNETClass(FManagedClassInfo* Info) :
         Info->CastFlags,
         (TCHAR*)Info->ClassConfigNameUTF8,
         RF_Public | RF_Standalone | RF_Transient | RF_MarkAsNative | RF_MarkAsRootSet,
-        Info->BaseClass->ClassConstructor,
+        &UUNETClass::ConstructObject,
         Info->BaseClass->ClassVTableHelperCtorCaller,
+        // Only references of native parent need a callback, managed ones are in token stream
         Info->BaseClass->ClassAddReferencedObjects
-    ) {}
+    ),
+    LayoutHash(Info->GetLayoutHash()),
+    DirtyMaskOffset(Info->GetDirtyMaskOffset(Version)),
+    BulkLayoutHash(0),
+    bCanBulkSerialize(false) {
+    SetDefaultValues(Info->BaseClass, OwnDefaultValues);
+    SetReplicatedProperties(Info, Version);
+
+    for (int32 i = 0; i < Info->NumProperties; i++) {
+        DirtyTrackedNames.Add(FName(UTF8_TO_TCHAR(Info->PropertyArray[i]->NameUTF8)));
+    }
+
+    if (IsManaged(Info->BaseClass)) {
+        FScopeLock Lock(&InstancesLock);
+        static_cast<UUNETClass*>(Info->BaseClass)->ManagedChildren.Add(this);
+    }
+
+    static FManagedInstanceTracker InstanceTracker;
+}
+
+UUNETClass::~UUNETClass() {
+    // Instances outlive class only on shutdown, when objects are destroyed in any order
+    FScopeLock Lock(&InstancesLock);
+
+    for (auto It = InstanceClasses.CreateIterator(); It; ++It) {
+        if (It->Value == this) {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void UUNETClass::DetachFromParent() {
+    if (auto ManagedParent = FindManaged(GetSuperClass())) {
+        FScopeLock Lock(&InstancesLock);
+        ManagedParent->ManagedChildren.Remove(this);
+    }
+}
+
+void UUNETClass::SetDefaultValues(UClass* BaseClass, const TArray<uint8>& OwnDefaultValues) {
+    if (IsManaged(BaseClass)) {
+        auto ManagedParent = static_cast<UUNETClass*>(BaseClass);
+
+        NativeConstructor = ManagedParent->NativeConstructor;
+        ManagedPropertiesOffset = ManagedParent->ManagedPropertiesOffset;
+        DefaultValues = ManagedParent->DefaultValues;
+    }
+    else {
+        NativeConstructor = BaseClass->ClassConstructor;
+        ManagedPropertiesOffset = BaseClass->PropertiesSize;
+        DefaultValues.Reset();
+    }
+
+    DefaultValues.Append(OwnDefaultValues);
+
+    bHasDefaultValues = DefaultValues.ContainsByPredicate([](uint8 Value) { return Value != 0; });
+}
+
+bool UUNETClass::HasSameLayout(const FManagedClassInfo* Info) const {
+    // Properties of the same size can still be renamed or retyped, their FProperties, dirty bits and bulk layout would be stale then
+    return GetSuperClass() == Info->BaseClass && PropertiesSize == Info->PropertiesSize && LayoutHash == Info->GetLayoutHash();
+}
+
+void UUNETClass::SetReplicatedProperties(const FManagedClassInfo* Info, EManagedClassInfoVersion Version) {
+    ReplicatedProperties.Reset();
+
+    auto ReplicationParams = Info->GetReplicationParams(Version);
+
+    for (int32 i = 0; i < Info->NumProperties; i++) {
+        auto Property = Info->PropertyArray[i];
+
+        if (!(Property->PropertyFlags & CPF_Net)) {
+            continue;
+        }
+
+        auto& Replicated = ReplicatedProperties.AddDefaulted_GetRef();
+        Replicated.Name = FName(UTF8_TO_TCHAR(Property->NameUTF8));
+
+        if (ReplicationParams) {
+            Replicated.Params = ReplicationParams[i];
+        }
+        else {
+            Replicated.Params = { COND_None, REPNOTIFY_OnChanged, false };
+        }
+    }
+
+    if (ReplicatedProperties.Num() > 0 && !Info->BaseClass->IsChildOf<AUNETActor>() && !Info->BaseClass->IsChildOf<UUNETActorComponent>()) {
+        UE_LOG(LogUNET, Warning, TEXT("Managed class %s has replicated properties, but they are replicated only when class is derived from UNETActor or UNETActorComponent"),
+            Info->ClassName);
+    }
+}
+
+void UUNETClass::GetLifetimeReplicatedProps(const UClass* Class, TArray<FLifetimeProperty>& OutLifetimeProps) {
+    for (auto Managed = FindManaged(const_cast<UClass*>(Class)); Managed; Managed = FindManaged(Managed->GetSuperClass())) {
+        for (auto& Replicated : Managed->ReplicatedProperties) {
+            auto Property = FindFProperty<FProperty>(Managed, Replicated.Name);
+
+            if (!Property || !Property->HasAnyPropertyFlags(CPF_Net)) {
+                continue;
+            }
+
+            FDoRepLifetimeParams Params;
+            Params.Condition = (ELifetimeCondition)Replicated.Params.Condition;
+            Params.RepNotifyCondition = (ELifetimeRepNotifyCondition)Replicated.Params.RepNotifyCondition;
+            Params.bIsPushBased = Replicated.Params.bIsPushBased != 0;
+
+            RegisterReplicatedLifetimeProperty(Property, OutLifetimeProps, Params);
+        }
+    }
+}
+
+void UUNETClass::Link(FArchive& Ar, bool bRelinkExistingProperties) {
+    UClass::Link(Ar, bRelinkExistingProperties);
+
+    DirtyTrackedProperties.Reset();
+
+    for (auto Name : DirtyTrackedNames) {
+        DirtyTrackedProperties.Add(FindFProperty<FProperty>(this, Name));
+    }
+
+    SetBulkLayout();
+}
+
+void UUNETClass::ForEachDirtyProperty(UObject* Object, TFunctionRef<void(const FProperty*)> Callback, bool bClear) {
+    for (auto Class = FindManaged(Object->GetClass()); Class; Class = FindManaged(Class->GetSuperClass())) {
+        if (Class->DirtyMaskOffset == INDEX_NONE) {
+            continue;
+        }
+
+        auto Mask = (uint64*)((uint8*)Object + Class->DirtyMaskOffset);
+        auto NumWords = FManagedClassInfo::GetDirtyMaskSize(Class->DirtyTrackedNames.Num()) / (int32)sizeof(uint64);
+
+        for (int32 Word = 0; Word < NumWords; Word++) {
+            // Bits are cleared before callbacks, so properties written by callbacks are reported next time
+            auto Bits = Mask[Word];
+
+            if (bClear) {
+                Mask[Word] = 0;
+            }
+
+            while (Bits) {
+                auto Bit = (int32)FMath::CountTrailingZeros64(Bits);
+                Bits &= Bits - 1;
+
+                auto Index = Word * 64 + Bit;
+
+                if (Class->DirtyTrackedProperties.IsValidIndex(Index) && Class->DirtyTrackedProperties[Index]) {
+                    Callback(Class->DirtyTrackedProperties[Index]);
+                }
+            }
+        }
+    }
+}
+
+bool UUNETClass::HasDirtyProperties(const UObject* Object) {
+    for (auto Class = FindManaged(Object->GetClass()); Class; Class = FindManaged(Class->GetSuperClass())) {
+        if (Class->DirtyMaskOffset == INDEX_NONE) {
+            continue;
+        }
+
+        auto Mask = (const uint64*)((const uint8*)Object + Class->DirtyMaskOffset);
+        auto NumWords = FManagedClassInfo::GetDirtyMaskSize(Class->DirtyTrackedNames.Num()) / (int32)sizeof(uint64);
+
+        for (int32 Word = 0; Word < NumWords; Word++) {
+            if (Mask[Word]) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void UUNETClass::ClearDirtyProperties(UObject* Object) {
+    for (auto Class = FindManaged(Object->GetClass()); Class; Class = FindManaged(Class->GetSuperClass())) {
+        if (Class->DirtyMaskOffset != INDEX_NONE) {
+            FMemory::Memzero((uint8*)Object + Class->DirtyMaskOffset, FManagedClassInfo::GetDirtyMaskSize(Class->DirtyTrackedNames.Num()));
+        }
+    }
+}
+
+void UUNETClass::SetBulkLayout() {
+    BulkLayout.Reset();
+    BulkLayoutHash = 0;
+    bCanBulkSerialize = true;
+
+    for (TFieldIterator<FProperty> It(this); It; ++It) {
+        auto Property = *It;
+
+        if (Property->GetOffset_ForInternal() < ManagedPropertiesOffset) {
+            continue;
+        }
+
+        auto Type = Property->GetClass()->GetFName();
+
+        // Managed properties are plain values or object pointers, anything else needs its own serializer
+        if (!IsObjectPropertyType(Type) && !Property->IsA<FNumericProperty>() && !Property->IsA<FBoolProperty>()) {
+            bCanBulkSerialize = false;
+        }
+
+        BulkLayout.Add({ Property->GetFName(), Type, Property->GetOffset_ForInternal() - ManagedPropertiesOffset, Property->GetSize(), Property });
+    }
+
+    // Own properties are iterated before inherited ones
+    BulkLayout.Sort([](const FBulkProperty& Lhs, const FBulkProperty& Rhs) { return Lhs.Offset < Rhs.Offset; });
+
+    // Names are hashed as strings, indices of FName differ between runs
+    for (auto& Property : BulkLayout) {
+        BulkLayoutHash = FCrc::StrCrc32(*Property.Name.ToString(), BulkLayoutHash);
+        BulkLayoutHash = FCrc::StrCrc32(*Property.Type.ToString(), BulkLayoutHash);
+        BulkLayoutHash = FCrc::MemCrc32(&Property.Offset, sizeof(Property.Offset), BulkLayoutHash);
+        BulkLayoutHash = FCrc::MemCrc32(&Property.Size, sizeof(Property.Size), BulkLayoutHash);
+    }
+}
+
+bool UUNETClass::ShouldBulkSerialize(FArchive& Ar) const {
+    if (!bCanBulkSerialize || BulkLayout.Num() == 0 || !GetDefault<UUNETSettings>()->bBulkSerializeManagedProperties) {
+        return false;
+    }
+
+    // Block is written as a whole, so archives that filter properties, like save games without CPF_SaveGame, get tagged ones
+    for (auto& Property : BulkLayout) {
+        if (!Property.Property->ShouldSerializeValue(Ar)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void UUNETClass::SerializeTaggedProperties(FStructuredArchive::FSlot Slot, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults, const UObject* BreakRecursionIfFullyLoad) const {
+    auto& Ar = Slot.GetUnderlyingArchive();
+
+    // Undo buffer and duplication compare and fix properties one by one, text formats keep tags for readability
+    if (Ar.IsTextFormat() || !Ar.IsPersistent() || Ar.IsTransacting() || (!Ar.IsSaving() && !Ar.IsLoading())) {
+        UClass::SerializeTaggedProperties(Slot, Data, DefaultsStruct, Defaults, BreakRecursionIfFullyLoad);
+        return;
+    }
+
+    Ar.UsingCustomVersion(FUNETCustomVersion::GUID);
+
+    if (Ar.IsLoading() && Ar.CustomVer(FUNETCustomVersion::GUID) < FUNETCustomVersion::BulkManagedProperties) {
+        UClass::SerializeTaggedProperties(Slot, Data, DefaultsStruct, Defaults, BreakRecursionIfFullyLoad);
+        return;
+    }
+
+    auto Format = (uint8)(Ar.IsSaving() && ShouldBulkSerialize(Ar) ? EManagedPropertiesFormat::Bulk : EManagedPropertiesFormat::Tagged);
+    auto Record = Slot.EnterRecord();
+
+    Record << SA_VALUE(TEXT("ManagedPropertiesFormat"), Format);
+
+    if (Format == (uint8)EManagedPropertiesFormat::Tagged) {
+        UClass::SerializeTaggedProperties(Record.EnterField(TEXT("Properties")), Data, DefaultsStruct, Defaults, BreakRecursionIfFullyLoad);
+        return;
+    }
+
+    // Properties of native parent are still tagged, they can change with engine version
+    auto NativeClass = GetSuperClass();
+
+    while (IsManaged(NativeClass)) {
+        NativeClass = NativeClass->GetSuperClass();
+    }
+
+    NativeClass->SerializeTaggedProperties(Record.EnterField(TEXT("Properties")), Data, DefaultsStruct, Defaults, BreakRecursionIfFullyLoad);
+
+    if (Ar.IsSaving()) {
+        SaveBulkProperties(Ar, Data);
+    }
+    else {
+        LoadBulkProperties(Ar, Data);
+
+        // Block includes dirty bits as they were at save, loaded values are not changes
+        ClearDirtyProperties((UObject*)Data);
+    }
+}
+
+//   Note: Block is preceded by its layout, so it can be loaded after properties are added, removed or moved.
+//   In packages the layout is written only by the first saved instance of class, others refer to that instance.
+//   Object references are written after the block as regular references, so linker can resolve imports.
+void UUNETClass::SaveBulkProperties(FArchive& Ar, uint8* Data) const {
+    auto Magic = BulkPropertiesMagic;
+    auto LayoutHash = BulkLayoutHash;
+    auto BlockSize = PropertiesSize - ManagedPropertiesOffset;
+    auto Object = (UObject*)Data;
+    auto LayoutOwner = Object;
+
+    // Save games and other archives without linker can't refer to other objects of the same file
+    if (Ar.GetLinker()) {
+        static auto PreSaveHandle = UPackage::PreSavePackageWithContextEvent.AddLambda([](UPackage* Package, FObjectPreSaveContext) {
+            FScopeLock Lock(&BulkLayoutsLock);
+
+            for (auto It = SavedBulkLayoutOwners.CreateIterator(); It; ++It) {
+                if (It->Key.Key == Package || !It->Value.IsValid()) {
+                    It.RemoveCurrent();
+                }
+            }
+        });
+
+        FScopeLock Lock(&BulkLayoutsLock);
+        auto& Owner = SavedBulkLayoutOwners.FindOrAdd({ Object->GetPackage(), this });
+
+        if (!Owner.IsValid()) {
+            Owner = Object;
+        }
+
+        LayoutOwner = Owner.Get();
+    }
+
+    auto bHasLayout = (uint8)(LayoutOwner == Object);
+
+    Ar << Magic << LayoutHash << bHasLayout;
+
+    if (bHasLayout) {
+        auto NumProperties = BulkLayout.Num();
+        Ar << NumProperties;
+
+        for (auto& Property : BulkLayout) {
+            auto Name = Property.Name;
+            auto Type = Property.Type;
+            auto Offset = Property.Offset;
+            auto Size = Property.Size;
+
+            Ar << Name << Type << Offset << Size;
+        }
+    }
+    else {
+        Ar << LayoutOwner;
+    }
+
+    // Pointers are meaningless after load, they are zeroed to keep saved packages deterministic
+    TArray<uint8, TInlineAllocator<256>> Block;
+    Block.Append(Data + ManagedPropertiesOffset, BlockSize);
+
+    for (auto& Property : BulkLayout) {
+        if (IsObjectPropertyType(Property.Type)) {
+            FMemory::Memzero(Block.GetData() + Property.Offset, Property.Size);
+        }
+    }
+
+    for (auto Class = this; Class; Class = FindManaged(Class->GetSuperClass())) {
+        if (Class->DirtyMaskOffset != INDEX_NONE) {
+            FMemory::Memzero(Block.GetData() + Class->DirtyMaskOffset - ManagedPropertiesOffset, FManagedClassInfo::GetDirtyMaskSize(Class->DirtyTrackedNames.Num()));
+        }
+    }
+
+    Ar << BlockSize;
+    Ar.Serialize(Block.GetData(), BlockSize);
+
+    for (auto& Property : BulkLayout) {
+        if (!IsObjectPropertyType(Property.Type)) {
+            continue;
+        }
+
+        auto Objects = (UObject**)(Data + ManagedPropertiesOffset + Property.Offset);
+
+        for (int32 i = 0; i < Property.Size / (int32)sizeof(UObject*); i++) {
+            Ar << Objects[i];
+        }
+    }
+}
+
+void UUNETClass::LoadBulkProperties(FArchive& Ar, uint8* Data) const {
+    uint32 Magic = 0;
+    uint32 LayoutHash = 0;
+    uint8 bHasLayout = 1;
+
+    Ar << Magic << LayoutHash;
+
+    if (Ar.CustomVer(FUNETCustomVersion::GUID) >= FUNETCustomVersion::SharedBulkLayouts) {
+        Ar << bHasLayout;
+    }
+
+    if (Magic != BulkPropertiesMagic) {
+        UE_LOG(LogUNET, Error, TEXT("Managed properties of %s class are corrupted"), *GetName());
+        Ar.SetError();
+        return;
+    }
+
+    TArray<FBulkProperty> SavedLayout;
+    auto bIsLayoutKnown = false;
+
+    if (bHasLayout) {
+        int32 NumProperties = 0;
+        Ar << NumProperties;
+
+        if (NumProperties < 0 || NumProperties > MAX_uint16) {
+            UE_LOG(LogUNET, Error, TEXT("Managed properties of %s class are corrupted"), *GetName());
+            Ar.SetError();
+            return;
+        }
+
+        SavedLayout.SetNum(NumProperties);
+
+        for (auto& Property : SavedLayout) {
+            Ar << Property.Name << Property.Type << Property.Offset << Property.Size;
+            Property.Property = nullptr;
+        }
+
+        bIsLayoutKnown = true;
+
+        // Current layout is always known, only outdated ones are kept for blocks without table
+        if (LayoutHash != BulkLayoutHash && !Ar.IsError()) {
+            FScopeLock Lock(&BulkLayoutsLock);
+            KnownBulkLayouts.Add(LayoutHash, SavedLayout);
+        }
+    }
+    else {
+        UObject* LayoutOwner = nullptr;
+        Ar << LayoutOwner;
+
+        if (LayoutHash == BulkLayoutHash) {
+            bIsLayoutKnown = true;
+        }
+        else {
+            auto bIsCached = false;
+
+            {
+                FScopeLock Lock(&BulkLayoutsLock);
+                bIsCached = KnownBulkLayouts.Contains(LayoutHash);
+            }
+
+            // Owner is usually loaded first, otherwise it is loaded now and caches its table
+            if (LayoutOwner && !bIsCached) {
+                Ar.Preload(LayoutOwner);
+            }
+
+            FScopeLock Lock(&BulkLayoutsLock);
+
+            if (auto KnownLayout = KnownBulkLayouts.Find(LayoutHash)) {
+                SavedLayout = *KnownLayout;
+                bIsLayoutKnown = true;
+            }
+        }
+    }
+
+    int32 BlockSize = 0;
+    Ar << BlockSize;
+
+    if (Ar.IsError() || BlockSize < 0) {
+        Ar.SetError();
+        return;
+    }
+
+    // References follow the block in order of saved layout, so without it the rest of stream can't be read
+    if (!bIsLayoutKnown) {
+        UE_LOG(LogUNET, Error, TEXT("Layout of managed properties of %s class is changed since save and its saved table is not loaded"), *GetName());
+        Ar.SetError();
+        return;
+    }
+
+    auto bIsSameLayout = LayoutHash == BulkLayoutHash && BlockSize == PropertiesSize - ManagedPropertiesOffset;
+
+    // Fast path: layout is not changed since save, so block is copied as is and object slots are overwritten below
+    if (bIsSameLayout) {
+        Ar.Serialize(Data + ManagedPropertiesOffset, BlockSize);
+
+        for (auto& Property : BulkLayout) {
+            if (IsObjectPropertyType(Property.Type)) {
+                auto Objects = (UObject**)(Data + ManagedPropertiesOffset + Property.Offset);
+
+                for (int32 i = 0; i < Property.Size / (int32)sizeof(UObject*); i++) {
+                    Ar << Objects[i];
+                }
+            }
+        }
+
+        return;
+    }
+
+    UE_LOG(LogUNET, Verbose, TEXT("Layout of %s class is changed since save, managed properties are matched by names"), *GetName());
+
+    // Block without table has the current layout, only its size differs, so properties are matched the same way
+    if (!bHasLayout && LayoutHash == BulkLayoutHash) {
+        SavedLayout = BulkLayout;
+    }
+
+    TArray<uint8, TInlineAllocator<256>> Block;
+    Block.SetNumUninitialized(BlockSize);
+    Ar.Serialize(Block.GetData(), BlockSize);
+
+    for (auto& Saved : SavedLayout) {
+        auto Current = BulkLayout.FindByPredicate([&](const FBulkProperty& Property) {
+            return Property.Name == Saved.Name && Property.Type == Saved.Type && Property.Size == Saved.Size;
+        });
+
+        if (!Current) {
+            UE_LOG(LogUNET, Verbose, TEXT("Saved property %s of %s class is removed or changed, it keeps default value"), *Saved.Name.ToString(), *GetName());
+        }
+
+        if (IsObjectPropertyType(Saved.Type)) {
+            // References are read even for removed properties, they are a part of stream
+            for (int32 i = 0; i < Saved.Size / (int32)sizeof(UObject*); i++) {
+                UObject* Object = nullptr;
+                Ar << Object;
+
+                if (Current) {
+                    ((UObject**)(Data + ManagedPropertiesOffset + Current->Offset))[i] = Object;
+                }
+            }
+        }
+        else if (Current && Saved.Offset >= 0 && (int64)Saved.Offset + Saved.Size <= BlockSize) {
+            FMemory::Memcpy(Data + ManagedPropertiesOffset + Current->Offset, Block.GetData() + Saved.Offset, Saved.Size);
+        }
+    }
+}
+
+void UUNETClass::ConstructObject(const FObjectInitializer& ObjectInitializer) {
+    auto Class = FindManaged(ObjectInitializer.GetClass());
+
+    check(Class);
+
+    Class->NativeConstructor(ObjectInitializer);
+
+    auto Object = ObjectInitializer.GetObj();
+
+    // Memory of new objects is zeroed, so only non-zero defaults have to be copied
+    if (Class->bHasDefaultValues) {
+        FMemory::Memcpy((uint8*)Object + Class->ManagedPropertiesOffset, Class->DefaultValues.GetData(), Class->DefaultValues.Num());
+    }
+
+    if (!Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)) {
+        FScopeLock Lock(&InstancesLock);
+        Class->Instances.Add(Object);
+        InstanceClasses.Add(GUObjectArray.ObjectToIndex(Object), Class);
+    }
+}
+
+int32 UUNETClass::QueryInstances(UClass* Class, UObject** OutObjects, void** OutPropertyBases, int32 Capacity) {
+    auto ManagedClass = FindManaged(Class);
+
+    if (!ManagedClass) {
+        return 0;
+    }
+
+    FScopeLock Lock(&InstancesLock);
+
+    // Blueprint classes share instance list of their managed parent, so their instances are filtered by class
+    return ManagedClass->CollectInstances(ManagedClass != Class ? Class : nullptr, OutObjects, OutPropertyBases, Capacity, 0);
+}
+
+int32 UUNETClass::CollectInstances(UClass* Filter, UObject** OutObjects, void** OutPropertyBases, int32 Capacity, int32 Count) const {
+    for (auto Object : Instances) {
+        if (!IsValid(Object) || Object->IsUnreachable() || Filter && !Object->IsA(Filter)) {
+            continue;
+        }
+
+        if (Count < Capacity) {
+            OutObjects[Count] = Object;
+
+            if (OutPropertyBases) {
+                OutPropertyBases[Count] = (uint8*)Object + ManagedPropertiesOffset;
+            }
+        }
+
+        Count++;
+    }
+
+    for (auto Child : ManagedChildren) {
+        Count = Child->CollectInstances(Filter, OutObjects, OutPropertyBases, Capacity, Count);
+    }
+
+    return Count;
+}
+
+/**
+* Called by C# code to process all instances of managed class at once
+*/
+int32 UNET::QueryInstances(UClass* Class, UObject** OutObjects, void** OutPropertyBases, int32 Capacity) {
+    return UUNETClass::QueryInstances(Class, OutObjects, OutPropertyBases, Capacity);
+}
 
 /**
 * Called by C# generated static boilerplate code
 */
-static UClass* UNET::OuterRegisterInternal(FManagedClassInfo* info)
+UClass* UNET::OuterRegisterInternal(FManagedClassInfo* info)
 {
     if (!info->RegistrationInfo->OuterSingleton)
     {
+        auto StartTime = FPlatformTime::Seconds();
+        ON_SCOPE_EXIT { ClassRegistry::AddRegistrationTime(FPlatformTime::Seconds() - StartTime, false); };
+
         UECodeGen_Private::ConstructUClass(info->RegistrationInfo->OuterSingleton, *info);
+
+        // Object properties of managed class are described to GC by reference token stream,
+        // so reachability analysis traverses them like native UPROPERTYs, without AddReferencedObjects callbacks.
+        // During initial load streams of all classes are assembled by GC itself.
+        if (!GIsInitialLoad) {
+            info->RegistrationInfo->OuterSingleton->AssembleReferenceTokenStream();
+        }
     }
     return info->RegistrationInfo->OuterSingleton;
 }
@@ -31,11 +674,11 @@ static UClass* UNET::OuterRegisterInternal(FManagedClassInfo* info)
 /**
 * Called by C# generated static boilerplate code
 */
-static UClass* UNET::InnerRegisterInternal(FManagedClassInfo* info)
+UClass* UNET::InnerRegisterInternal(FManagedClassInfo* info)
 {
     if (!info->RegistrationInfo->InnerSingleton)
     {
-        auto ReturnClass = ::new (GUObjectAllocator.AllocateUObject(sizeof(UUNETClass), alignof(UUNETClass), true)) UUNETClass(info);
+        auto ReturnClass = ::new (GUObjectAllocator.AllocateUObject(sizeof(UUNETClass), alignof(UUNETClass), true)) UUNETClass(info, ClassRegistry::GetVersion(info->ClassName), ClassRegistry::GetDefaultValues(info->ClassName));
 
         check(ReturnClass);
 
@@ -48,13 +691,75 @@ static UClass* UNET::InnerRegisterInternal(FManagedClassInfo* info)
         );
 
         info->RegistrationInfo->InnerSingleton = ReturnClass;
+
+        ClassRegistry::SetClass(info, ReturnClass);
     }
     return info->RegistrationInfo->InnerSingleton;
 }
 
-static void UNET::RegisterNewClass(FManagedClassInfo* Info) {
+void UNET::RegisterNewClass(FManagedClassInfo* Info, EManagedClassInfoVersion Version) {
+    if (!FManagedClassInfo::IsSupportedVersion(Version)) {
+        UE_LOG(LogUNET, Error, TEXT("Managed class %s has info of version %d, but UNET supports versions up to %d. Plugin needs UNET it was generated for"),
+            Info->ClassName, (int32)Version, (int32)EManagedClassInfoVersion::Latest);
+        return;
+    }
+
+    auto StartTime = FPlatformTime::Seconds();
+    ON_SCOPE_EXIT { ClassRegistry::AddRegistrationTime(FPlatformTime::Seconds() - StartTime); };
+
+    TArray<uint8> DefaultValues;
+    Info->Initialize(DefaultValues, Version);
+
+    RegisterResolvedClass(Info, MoveTemp(DefaultValues), Version);
+}
+
+void UNET::RegisterResolvedClass(FManagedClassInfo* Info, TArray<uint8>&& DefaultValues, EManagedClassInfoVersion Version) {
+    checkf(FManagedClassInfo::IsSupportedVersion(Version), TEXT("Unsupported info version %d of managed class %s"), (int32)Version, Info->ClassName);
+
+    if (auto ExistingClass = ClassRegistry::FindClass(Info->ClassName)) {
+
+        auto ManagedClass = UUNETClass::IsManaged(ExistingClass) ? static_cast<UUNETClass*>(ExistingClass) : nullptr;
+
+        if (ManagedClass && ManagedClass->HasSameLayout(Info)) {
+            // Class survived plugins unload, so there is nothing to construct again
+            Info->RegistrationInfo->InnerSingleton = ExistingClass;
+            Info->RegistrationInfo->OuterSingleton = ExistingClass;
+
+            ManagedClass->SetDefaultValues(Info->BaseClass, DefaultValues);
+            ManagedClass->SetReplicatedProperties(Info, Version);
+
+            ClassRegistry::Add(Info, Version, MoveTemp(DefaultValues), ExistingClass);
+
+            Info->IsRegistered = true;
+            return;
+        }
+
+        UE_LOG(LogUNET, Warning, TEXT("Layout of managed class %s is changed, old class will be replaced"), Info->ClassName);
+
+        if (ManagedClass) {
+            ManagedClass->DetachFromParent();
+        }
+
+        constexpr auto RenameFlags = REN_DontCreateRedirectors | REN_NonTransactional | REN_ForceNoResetLoaders;
+
+        // CDO of new class gets the same name under the same outer, so the old one is moved aside together with its class
+        if (auto OldDefaultObject = ExistingClass->GetDefaultObject(false)) {
+            OldDefaultObject->Rename(
+                *MakeUniqueObjectName(OldDefaultObject->GetOuter(), ExistingClass, *FString::Printf(TEXT("REINST_Default__%s"), Info->ClassName)).ToString(),
+                nullptr,
+                RenameFlags);
+        }
+
+        // The same way as UE hot reload does, old class is kept alive for existing instances under another name.
+        // Instances are not reinstanced, they keep old class and its layout until they are destroyed
+        ExistingClass->ClassFlags |= CLASS_NewerVersionExists;
+        ExistingClass->Rename(
+            *MakeUniqueObjectName(ExistingClass->GetOuter(), ExistingClass->GetClass(), *FString::Printf(TEXT("REINST_%s"), Info->ClassName)).ToString(),
+            nullptr,
+            RenameFlags);
+    }
 
-    Info->Initialize();
+    ClassRegistry::Add(Info, Version, MoveTemp(DefaultValues));
 
     RegisterCompiledInInfo(
         Info->OuterRegister,
@@ -0,0 +1,221 @@
+#include "UNETCommandBuffer.h"
+
+#include <Engine/Engine.h>
+#include <Engine/World.h>
+#include <GameFramework/Actor.h>
+#include <UObject/UObjectArray.h>
+#include <UObject/UnrealType.h>
+
+#include "Delegates.h"
+#include "LogUNET.h"
+
+UNET::FManagedObjectRef UNET::FManagedObjectRef::Make(UObject* Object) {
+    if (!Object) {
+        return { INDEX_NONE, 0 };
+    }
+
+    auto Index = GUObjectArray.ObjectToIndex(Object);
+
+    // Serial number is allocated the same way as by FWeakObjectPtr, it is thread safe
+    return { Index, GUObjectArray.AllocateSerialNumber(Index) };
+}
+
+UObject* UNET::FManagedObjectRef::Resolve() const {
+    if (ObjectIndex < 0 || SerialNumber == 0) {
+        return nullptr;
+    }
+
+    auto Item = GUObjectArray.IndexToObject(ObjectIndex);
+
+    // Slot of destroyed object gets a new serial number when it is reused
+    if (!Item || Item->GetSerialNumber() != SerialNumber || Item->IsUnreachable()) {
+        return nullptr;
+    }
+
+    return (UObject*)Item->Object;
+}
+
+namespace {
+
+    using namespace UNET;
+
+    // Payload of command with its trailing data, or nullptr when command is too small for it
+    template<typename TCommand>
+    const TCommand* GetPayload(const FManagedCommandHeader* Header, int64 TrailingSize = 0) {
+        auto RequiredSize = (int64)(sizeof(FManagedCommandHeader) + sizeof(TCommand)) + TrailingSize;
+        return TrailingSize >= 0 && Header->Size >= RequiredSize ? (const TCommand*)(Header + 1) : nullptr;
+    }
+
+    // Bitwise write is allowed only inside of plain old data property, so pointers, containers and strings can't be broken by it
+    bool IsPlainOldDataRange(UClass* Class, int32 Offset, int32 Size) {
+        for (TFieldIterator<FProperty> It(Class); It; ++It) {
+            auto PropertyOffset = It->GetOffset_ForInternal();
+
+            if (Offset >= PropertyOffset && Offset + (int64)Size <= PropertyOffset + (int64)It->GetSize()) {
+                return It->HasAllPropertyFlags(CPF_IsPlainOldData);
+            }
+        }
+
+        return false;
+    }
+
+    // Commands are recorded ahead of time, so objects can be destroyed before buffer is submitted or by earlier commands.
+    // Their references are resolved right before use, destroyed objects resolve to nullptr
+    bool ExecuteCommand(const FManagedCommandHeader* Header, UObject** OutResults, int32 ResultsCapacity) {
+        switch (Header->Type) {
+        case EManagedCommand::Log: {
+            auto Command = GetPayload<FManagedLogCommand>(Header);
+
+            if (!Command || !GetPayload<FManagedLogCommand>(Header, Command->Length * (int64)sizeof(TCHAR))) {
+                return false;
+            }
+
+            auto Message = FString(Command->Length, (const TCHAR*)(Command + 1));
+
+            if (!Message.IsEmpty()) {
+                UNET::LogManaged((ELogVerbosity::Type)Command->Verbosity, Message.GetCharArray().GetData());
+            }
+
+            return true;
+        }
+        case EManagedCommand::CallFunction: {
+            auto Command = GetPayload<FManagedCallFunctionCommand>(Header);
+
+            if (!Command || Command->ParamsOffset < (int32)sizeof(FManagedCommandHeader) || Command->ParamsOffset + (int64)Command->ParamsSize > Header->Size) {
+                return false;
+            }
+
+            auto Target = Command->Target.Resolve();
+            auto Function = Command->Function.Resolve<UFunction>();
+
+            if (!Function || !IsValid(Target) || !Target->IsA(Function->GetOwnerClass())) {
+                return false;
+            }
+
+            auto Params = (uint8*)Header + Command->ParamsOffset;
+
+            // Frame of another function or misaligned frame means that stub doesn't match function anymore
+            if (Command->ParamsSize < Function->ParmsSize || !IsAligned(Params, Function->GetMinAlignment())) {
+                UE_LOG(LogUNET, Error, TEXT("Parameters frame of size %d doesn't match %s"), Command->ParamsSize, *Function->GetPathName());
+                return false;
+            }
+
+            // Frame belongs to buffer, which is reset after submit, so function may write to it
+            UNET::CallFunction(Target, Function, Params);
+            return true;
+        }
+        case EManagedCommand::SetProperty: {
+            auto Command = GetPayload<FManagedSetPropertyCommand>(Header);
+
+            auto Target = Command ? Command->Target.Resolve() : nullptr;
+
+            if (!Command || !GetPayload<FManagedSetPropertyCommand>(Header, Command->Size) || !IsValid(Target)) {
+                return false;
+            }
+
+            if (Command->Size <= 0 || !IsPlainOldDataRange(Target->GetClass(), Command->Offset, Command->Size)) {
+                UE_LOG(LogUNET, Error, TEXT("Offset %d of size %d isn't plain old data property of %s"), Command->Offset, Command->Size, *Target->GetClass()->GetName());
+                return false;
+            }
+
+            FMemory::Memcpy((uint8*)Target + Command->Offset, Command + 1, Command->Size);
+            UNET::MarkPropertyDirty(Target, Command->RepIndex);
+            return true;
+        }
+        case EManagedCommand::MarkPropertyDirty: {
+            auto Command = GetPayload<FManagedMarkPropertyDirtyCommand>(Header);
+
+            auto Target = Command ? Command->Target.Resolve() : nullptr;
+
+            if (!IsValid(Target)) {
+                return false;
+            }
+
+            UNET::MarkPropertyDirty(Target, Command->RepIndex);
+            return true;
+        }
+        case EManagedCommand::SpawnActor: {
+            auto Command = GetPayload<FManagedSpawnActorCommand>(Header);
+
+            auto Class = Command ? Command->Class.Resolve<UClass>() : nullptr;
+
+            if (!Class || !Class->IsChildOf<AActor>()) {
+                return false;
+            }
+
+            auto World = GEngine->GetWorldFromContextObject(Command->WorldContext.Resolve(), EGetWorldErrorMode::LogAndReturnNull);
+            auto Actor = World ? World->SpawnActor(Class, &Command->Location, &Command->Rotation) : nullptr;
+
+            if (Command->ResultIndex >= 0 && Command->ResultIndex < ResultsCapacity) {
+                OutResults[Command->ResultIndex] = Actor;
+            }
+
+            return Actor != nullptr;
+        }
+        case EManagedCommand::DestroyActor: {
+            auto Command = GetPayload<FManagedDestroyActorCommand>(Header);
+            auto Actor = Command ? Command->Target.Resolve<AActor>() : nullptr;
+
+            return IsValid(Actor) && Actor->Destroy();
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+/**
+* Called by C# code when command buffer is submitted, commands are executed in the order they were recorded.
+* Objects are recorded as pointers, they are replaced by references at once, so objects destroyed by earlier commands are skipped.
+* Returns count of commands that were executed successfully or INDEX_NONE when buffer can't be executed at all
+*/
+int32 UNET::ExecuteCommands(uint8* Commands, int32 Size, const int32* RefOffsets, int32 NumRefs, UObject** OutResults, int32 ResultsCapacity) {
+    if (!IsInGameThread()) {
+        UE_LOG(LogUNET, Error, TEXT("Managed command buffer can only be submitted on game thread"));
+        return INDEX_NONE;
+    }
+
+    for (int32 i = 0; i < NumRefs; i++) {
+        auto RefOffset = RefOffsets[i];
+
+        if (RefOffset < 0 || RefOffset > Size - (int32)sizeof(FManagedObjectRef) || RefOffset % alignof(UObject*) != 0) {
+            UE_LOG(LogUNET, Error, TEXT("Managed command buffer has object at invalid offset %d, no commands are executed"), RefOffset);
+            return 0;
+        }
+    }
+
+    for (int32 i = 0; i < NumRefs; i++) {
+        auto Slot = Commands + RefOffsets[i];
+        *(FManagedObjectRef*)Slot = FManagedObjectRef::Make(*(UObject**)Slot);
+    }
+
+    int32 NumExecuted = 0;
+    int32 NumFailed = 0;
+    int32 Offset = 0;
+
+    while (Offset < Size) {
+        auto Header = (const FManagedCommandHeader*)(Commands + Offset);
+
+        // Malformed buffer means layout mismatch with managed side, nothing after it can be trusted
+        if (Size - Offset < (int32)sizeof(FManagedCommandHeader) || Header->Size < sizeof(FManagedCommandHeader) ||
+            Header->Size > (uint32)(Size - Offset) || Header->Size % FManagedCommandHeader::CommandAlignment != 0) {
+            UE_LOG(LogUNET, Error, TEXT("Managed command buffer is malformed at offset %d, %d commands are executed"), Offset, NumExecuted);
+            break;
+        }
+
+        if (ExecuteCommand(Header, OutResults, ResultsCapacity)) {
+            NumExecuted++;
+        }
+        else {
+            NumFailed++;
+        }
+
+        Offset += Header->Size;
+    }
+
+    if (NumFailed > 0) {
+        UE_LOG(LogUNET, Warning, TEXT("%d commands of managed command buffer are skipped, their objects are invalid or were not created"), NumFailed);
+    }
+
+    return NumExecuted;
+}
@@ -0,0 +1,134 @@
+#include "UNETDelegateHandler.h"
+
+#include <UObject/Package.h>
+#include <UObject/UnrealType.h>
+
+#include "Delegates.h"
+#include "LogUNET.h"
+
+TArray<UUNETDelegateHandler*> UUNETDelegateHandler::Handlers;
+
+const FName UUNETDelegateHandler::InvokeFunctionName = GET_FUNCTION_NAME_CHECKED(UUNETDelegateHandler, Invoke);
+
+void UUNETDelegateHandler::ProcessEvent(UFunction* Function, void* Params) {
+    if (Callback && Function->GetFName() == InvokeFunctionName) {
+        UNET::FManagedCallScope CallScope(DelegateProperty ? DelegateProperty->GetFName() : InvokeFunctionName);
+
+        Callback(Handle, Params);
+        return;
+    }
+
+    Super::ProcessEvent(Function, Params);
+}
+
+UUNETDelegateHandler* UUNETDelegateHandler::Bind(UObject* Target, FName DelegateName, UNET::FManagedDelegateCallback Callback, void* Handle, FName Owner) {
+    if (!IsValid(Target) || !Callback) {
+        return nullptr;
+    }
+
+    auto Property = Target->GetClass()->FindPropertyByName(DelegateName);
+
+    if (!Property || !Property->IsA<FMulticastDelegateProperty>() && !Property->IsA<FDelegateProperty>()) {
+        UE_LOG(LogUNET, Error, TEXT("%s doesn't have dynamic delegate %s"), *Target->GetClass()->GetName(), *DelegateName.ToString());
+        return nullptr;
+    }
+
+    auto Handler = NewObject<UUNETDelegateHandler>(GetTransientPackage());
+    Handler->Callback = Callback;
+    Handler->Handle = Handle;
+    Handler->Target = Target;
+    Handler->DelegateProperty = Property;
+    Handler->Owner = Owner;
+    Handler->AddToRoot();
+
+    FScriptDelegate Delegate;
+    Delegate.BindUFunction(Handler, InvokeFunctionName);
+
+    if (auto MulticastProperty = CastField<FMulticastDelegateProperty>(Property)) {
+        MulticastProperty->AddDelegate(MoveTemp(Delegate), Target);
+    }
+    else {
+        *CastFieldChecked<FDelegateProperty>(Property)->GetPropertyValuePtr_InContainer(Target) = MoveTemp(Delegate);
+    }
+
+    Handlers.Add(Handler);
+
+    return Handler;
+}
+
+void UUNETDelegateHandler::Unbind() {
+    if (auto BoundTarget = Target.Get()) {
+        FScriptDelegate Delegate;
+        Delegate.BindUFunction(this, InvokeFunctionName);
+
+        if (auto MulticastProperty = CastField<FMulticastDelegateProperty>(DelegateProperty)) {
+            MulticastProperty->RemoveDelegate(Delegate, BoundTarget);
+        }
+        else {
+            auto BoundDelegate = CastFieldChecked<FDelegateProperty>(DelegateProperty)->GetPropertyValuePtr_InContainer(BoundTarget);
+
+            // Delegate could be rebound to something else since then
+            if (*BoundDelegate == Delegate) {
+                BoundDelegate->Unbind();
+            }
+        }
+    }
+
+    Callback = nullptr;
+    Handle = nullptr;
+    Target.Reset();
+    DelegateProperty = nullptr;
+
+    RemoveFromRoot();
+    MarkAsGarbage();
+}
+
+void UUNETDelegateHandler::Unbind(UUNETDelegateHandler* Handler) {
+    if (Handlers.RemoveSwap(Handler)) {
+        Handler->Unbind();
+    }
+}
+
+void UUNETDelegateHandler::UnbindAll() {
+    // Handlers are already destroyed with the rest of UObjects
+    if (!UObjectInitialized()) {
+        Handlers.Empty();
+        return;
+    }
+
+    for (auto Handler : Handlers) {
+        Handler->Unbind();
+    }
+
+    Handlers.Empty();
+}
+
+void UUNETDelegateHandler::UnbindOwnedBy(FName Owner) {
+    for (int32 i = Handlers.Num() - 1; i >= 0; i--) {
+        auto Handler = Handlers[i];
+
+        if (Handler->Owner == Owner) {
+            Handlers.RemoveAtSwap(i);
+            Handler->Unbind();
+        }
+    }
+}
+
+/**
+* Called by C# code to subscribe managed handler to delegate of UObject
+*/
+UUNETDelegateHandler* UNET::BindDelegate(UObject* Target, const TCHAR* DelegateName, int32 NameLength, FManagedDelegateCallback Callback, void* Handle,
+    const TCHAR* OwnerName, int32 OwnerNameLength) {
+    return UUNETDelegateHandler::Bind(Target, FName(NameLength, DelegateName), Callback, Handle, FName(OwnerNameLength, OwnerName));
+}
+
+void UNET::UnbindDelegate(UUNETDelegateHandler* Handler) {
+    UUNETDelegateHandler::Unbind(Handler);
+}
+
+/**
+* Called by C# Plugin Loader before plugin is reloaded
+*/
+void UNET::UnbindOwnedDelegates(const TCHAR* OwnerName, int32 OwnerNameLength) {
+    UUNETDelegateHandler::UnbindOwnedBy(FName(OwnerNameLength, OwnerName));
+}
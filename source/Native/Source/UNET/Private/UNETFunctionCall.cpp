@@ -0,0 +1,85 @@
+#include "UNETFunctionCall.h"
+
+#include <UObject/Class.h>
+#include <UObject/Stack.h>
+#include <UObject/UnrealType.h>
+
+#include "Delegates.h"
+#include "LogUNET.h"
+
+namespace {
+
+    // Functions that only run their native thunk, everything else ProcessEvent does is not needed for them
+    bool CanInvokeDirectly(const UFunction* Function) {
+        return Function->HasAllFunctionFlags(FUNC_Native) &&
+            !Function->HasAnyFunctionFlags(FUNC_Net | FUNC_Event | FUNC_BlueprintEvent | FUNC_HasOutParms);
+    }
+}
+
+/**
+* Called by C# code once per call stub, parameters frame is built on managed side without native calls
+*/
+bool UNET::ResolveFunction(const TCHAR* ClassName, int32 ClassNameLength, const TCHAR* FunctionName, int32 FunctionNameLength,
+    FManagedFunctionInfo* OutInfo, int32* OutParamOffsets, int32 Capacity) {
+
+    auto ClassNameString = FString(ClassNameLength, ClassName);
+    auto Class = FindFirstObject<UClass>(*ClassNameString, EFindFirstObjectOptions::None);
+
+    if (!Class) {
+        UE_LOG(LogUNET, Error, TEXT("Can't resolve function %.*s, class %s is not found"), FunctionNameLength, FunctionName, *ClassNameString);
+        return false;
+    }
+
+    auto Function = Class->FindFunctionByName(FName(FunctionNameLength, FunctionName));
+
+    if (!Function) {
+        UE_LOG(LogUNET, Error, TEXT("Function %.*s is not found in class %s"), FunctionNameLength, FunctionName, *ClassNameString);
+        return false;
+    }
+
+    // Frame is written and discarded by managed side bitwise, so parameters must not need construction or destruction
+    OutInfo->NumParams = 0;
+
+    for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It) {
+        if (!It->HasAnyPropertyFlags(CPF_IsPlainOldData)) {
+            UE_LOG(LogUNET, Error, TEXT("Function %s has parameter %s of type %s, only plain old data parameters are supported"),
+                *Function->GetPathName(), *It->GetName(), *It->GetCPPType());
+            return false;
+        }
+
+        if (It->HasAnyPropertyFlags(CPF_ReturnParm)) {
+            continue;
+        }
+
+        if (OutInfo->NumParams < Capacity) {
+            OutParamOffsets[OutInfo->NumParams] = It->GetOffset_ForUFunction();
+        }
+
+        OutInfo->NumParams++;
+    }
+
+    OutInfo->Function = Function;
+    OutInfo->ParamsSize = Function->ParmsSize;
+    OutInfo->ParamsAlignment = Function->GetMinAlignment();
+    OutInfo->ReturnValueOffset = Function->ReturnValueOffset != MAX_uint16 ? Function->ReturnValueOffset : INDEX_NONE;
+
+    return true;
+}
+
+/**
+* Called by C# code with parameters frame laid out as described by ResolveFunction
+*/
+void UNET::CallFunction(UObject* Object, UFunction* Function, void* Params) {
+    checkSlow(Object && Object->IsA(Function->GetOwnerClass()));
+
+    if (!CanInvokeDirectly(Function)) {
+        Object->ProcessEvent(Function, Params);
+        return;
+    }
+
+    // The same frame ProcessEvent builds for native functions
+    FFrame Stack(Object, Function, Params, nullptr, Function->ChildProperties);
+    auto ReturnValue = Function->ReturnValueOffset != MAX_uint16 ? (uint8*)Params + Function->ReturnValueOffset : nullptr;
+
+    Function->Invoke(Object, Stack, ReturnValue);
+}
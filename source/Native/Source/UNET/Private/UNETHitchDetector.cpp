@@ -0,0 +1,380 @@
+#include "UNETHitchDetector.h"
+
+#include <atomic>
+
+#include <HAL/Runnable.h>
+#include <HAL/RunnableThread.h>
+#include <Misc/CoreDelegates.h>
+
+#include "Delegates.h"
+
+namespace {
+
+    using UNET::FManagedRuntimeState;
+
+    constexpr int32 MaxCallDepth = 16;
+    constexpr int32 MaxHistory = 64;
+    constexpr int32 MaxReportedCalls = 3;
+
+    struct FCallStats {
+        FName Name;
+        double Seconds;
+        int32 Count;
+    };
+
+    struct FHitch {
+        uint64 FrameNumber;
+        double FrameSeconds;
+        double ManagedSeconds;
+
+        TArray<FCallStats, TInlineAllocator<MaxReportedCalls>> TopCalls;
+
+        // Calls active on game thread when one of them exceeded threshold, empty if no single call did
+        FString StuckCalls;
+
+        FManagedRuntimeState RuntimeDelta;
+    };
+
+    FManagedRuntimeState GetRuntimeState() {
+        FManagedRuntimeState State = {};
+
+        if (UNET::PluginLoaderDelegates.GetRuntimeState) {
+            UNET::PluginLoaderDelegates.GetRuntimeState(&State);
+        }
+
+        return State;
+    }
+
+    FManagedRuntimeState GetRuntimeDelta(const FManagedRuntimeState& Start, const FManagedRuntimeState& End) {
+        FManagedRuntimeState Delta;
+
+        for (int32 Generation = 0; Generation < UE_ARRAY_COUNT(Delta.GCCounts); Generation++) {
+            Delta.GCCounts[Generation] = End.GCCounts[Generation] - Start.GCCounts[Generation];
+        }
+
+        Delta.AllocatedBytes = End.AllocatedBytes - Start.AllocatedBytes;
+        Delta.JitCompiledMethods = End.JitCompiledMethods - Start.JitCompiledMethods;
+        Delta.JitTimeTicks = End.JitTimeTicks - Start.JitTimeTicks;
+
+        return Delta;
+    }
+
+    FString DescribeRuntimeDelta(const FManagedRuntimeState& Delta) {
+        return FString::Printf(TEXT("GC %lld/%lld/%lld (gen 0/1/2), allocated %.1f KB, JIT %lld methods in %.2f ms"),
+            Delta.GCCounts[0], Delta.GCCounts[1], Delta.GCCounts[2],
+            Delta.AllocatedBytes / 1024.0,
+            Delta.JitCompiledMethods, Delta.JitTimeTicks / 10000.0);
+    }
+
+    FString DescribeCalls(TArrayView<const FCallStats> Calls) {
+        FString Result;
+
+        for (auto& Call : Calls) {
+            Result += FString::Printf(TEXT("%s%s %.2f ms (%d calls)"), Result.IsEmpty() ? TEXT("") : TEXT(", "), *Call.Name.ToString(), Call.Seconds * 1000.0, Call.Count);
+        }
+
+        return Result.IsEmpty() ? TEXT("none") : Result;
+    }
+
+    //   Note: Only game thread enters and leaves calls, watchdog thread reads call stack under lock.
+    //   Lock is uncontended unless watchdog is looking, so it is cheaper than managed call itself.
+    /**
+     *   Measures time spent in managed code by game thread.
+     */
+    class FHitchDetector : public FRunnable {
+
+        double ThresholdSeconds = 0.0;
+
+        FCriticalSection CallsLock;
+
+        FName Calls[MaxCallDepth];
+        int32 Depth = 0;
+
+        uint64 OutermostStartCycles = 0;
+        uint64 OutermostCallId = 0;
+        uint64 ReportedCallId = 0;
+
+        FString StuckCalls;
+        FManagedRuntimeState FrameStartState = {};
+
+        // Accessed only by game thread
+        TArray<FCallStats> FrameCalls;
+        double FrameManagedSeconds = 0.0;
+        uint64 FrameStartCycles = 0;
+
+        TArray<FHitch> History;
+        int32 NextHistoryIndex = 0;
+        int32 NumHitches = 0;
+
+        FRunnableThread* Thread = nullptr;
+        FEvent* WakeEvent = nullptr;
+        std::atomic<bool> bShouldStop = false;
+
+        FDelegateHandle EndFrameHandle;
+
+    public:
+
+        std::atomic<bool> bIsActive = false;
+
+        void Start(float ThresholdMs) {
+            Stop();
+
+            ThresholdSeconds = ThresholdMs / 1000.0;
+            FrameStartCycles = 0;
+            FrameStartState = GetRuntimeState();
+
+            History.Reset();
+            NextHistoryIndex = 0;
+            NumHitches = 0;
+
+            bShouldStop = false;
+            WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+            Thread = FRunnableThread::Create(this, TEXT("UNET Hitch Detector"), 0, TPri_BelowNormal);
+
+            EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FHitchDetector::EndFrame);
+            bIsActive = true;
+
+            UE_LOG(LogUNETManaged, Log, TEXT("Managed hitch detector is started with %.1f ms threshold"), ThresholdMs);
+        }
+
+        void Stop() {
+            if (!bIsActive) {
+                return;
+            }
+
+            bIsActive = false;
+            FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+            bShouldStop = true;
+            WakeEvent->Trigger();
+
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+
+            FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+            WakeEvent = nullptr;
+        }
+
+        void EnterCall(FName Name) {
+            FScopeLock Lock(&CallsLock);
+
+            if (Depth == 0) {
+                OutermostStartCycles = FPlatformTime::Cycles64();
+                OutermostCallId++;
+            }
+
+            if (Depth < MaxCallDepth) {
+                Calls[Depth] = Name;
+            }
+
+            Depth++;
+        }
+
+        void LeaveCall() {
+            uint64 StartCycles;
+            FName Name;
+
+            {
+                FScopeLock Lock(&CallsLock);
+
+                if (--Depth > 0) {
+                    return;
+                }
+
+                StartCycles = OutermostStartCycles;
+                Name = Calls[0];
+            }
+
+            // Nested calls are already included in time of the outermost one
+            auto Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+            FrameManagedSeconds += Seconds;
+
+            auto Stats = FrameCalls.FindByPredicate([&](const FCallStats& Call) { return Call.Name == Name; });
+
+            if (!Stats) {
+                Stats = &FrameCalls.Add_GetRef({ Name, 0.0, 0 });
+            }
+
+            Stats->Seconds += Seconds;
+            Stats->Count++;
+        }
+
+        void EndFrame() {
+            auto NowCycles = FPlatformTime::Cycles64();
+
+            // Runtime is snapshotted every frame, GC and JIT also run for tasks and other threads in frames without game thread calls,
+            // so delta of a hitch covers only its own frame. Counters are read without allocations, so it is cheap
+            auto State = GetRuntimeState();
+
+            if (FrameCalls.Num() > 0 && FrameManagedSeconds >= ThresholdSeconds) {
+                RecordHitch(FrameStartCycles ? FPlatformTime::ToSeconds64(NowCycles - FrameStartCycles) : 0.0, State);
+            }
+
+            FrameStartCycles = NowCycles;
+            FrameManagedSeconds = 0.0;
+            FrameCalls.Reset();
+
+            FScopeLock Lock(&CallsLock);
+            FrameStartState = State;
+            StuckCalls.Reset();
+        }
+
+        void RecordHitch(double FrameSeconds, const FManagedRuntimeState& State) {
+            FHitch Hitch;
+            Hitch.FrameNumber = GFrameCounter;
+            Hitch.FrameSeconds = FrameSeconds;
+            Hitch.ManagedSeconds = FrameManagedSeconds;
+
+            FrameCalls.Sort([](const FCallStats& Lhs, const FCallStats& Rhs) { return Lhs.Seconds > Rhs.Seconds; });
+            Hitch.TopCalls.Append(FrameCalls.GetData(), FMath::Min(FrameCalls.Num(), MaxReportedCalls));
+
+            {
+                FScopeLock Lock(&CallsLock);
+                Hitch.StuckCalls = StuckCalls;
+                Hitch.RuntimeDelta = GetRuntimeDelta(FrameStartState, State);
+            }
+
+            UE_LOG(LogUNETManaged, Warning, TEXT("Hitch in frame %llu: %.2f ms of %.2f ms frame spent in managed code. Top calls: %s. Runtime: %s"),
+                Hitch.FrameNumber, Hitch.ManagedSeconds * 1000.0, Hitch.FrameSeconds * 1000.0,
+                *DescribeCalls(Hitch.TopCalls), *DescribeRuntimeDelta(Hitch.RuntimeDelta));
+
+            if (History.Num() < MaxHistory) {
+                History.Add(MoveTemp(Hitch));
+            }
+            else {
+                History[NextHistoryIndex] = MoveTemp(Hitch);
+            }
+
+            NextHistoryIndex = (NextHistoryIndex + 1) % MaxHistory;
+            NumHitches++;
+        }
+
+        // Watchdog, it sees calls that are still running, so the stack is captured while hitch is happening
+        virtual uint32 Run() override {
+            auto WaitMs = FMath::Max(1, FMath::FloorToInt32(ThresholdSeconds * 1000.0 / 2));
+
+            while (!bShouldStop) {
+                WakeEvent->Wait(WaitMs);
+
+                FString Stack;
+                double Seconds;
+
+                {
+                    FScopeLock Lock(&CallsLock);
+
+                    if (Depth == 0 || OutermostCallId == ReportedCallId) {
+                        continue;
+                    }
+
+                    Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - OutermostStartCycles);
+
+                    if (Seconds < ThresholdSeconds) {
+                        continue;
+                    }
+
+                    ReportedCallId = OutermostCallId;
+
+                    for (int32 i = 0; i < FMath::Min(Depth, MaxCallDepth); i++) {
+                        Stack += (i > 0 ? TEXT(" > ") : TEXT("")) + Calls[i].ToString();
+                    }
+                }
+
+                // Managed call from this thread waits while GC is suspending runtime, so its time is a part of the report
+                auto State = GetRuntimeState();
+
+                FManagedRuntimeState Delta;
+
+                {
+                    FScopeLock Lock(&CallsLock);
+                    Delta = GetRuntimeDelta(FrameStartState, State);
+                    StuckCalls = Stack;
+                }
+
+                UE_LOG(LogUNETManaged, Warning, TEXT("Game thread is in managed code for %.2f ms: %s. Runtime since frame start: %s"),
+                    Seconds * 1000.0, *Stack, *DescribeRuntimeDelta(Delta));
+            }
+
+            return 0;
+        }
+
+        void Report(FOutputDevice& Ar) {
+            if (!bIsActive) {
+                Ar.Logf(TEXT("Managed hitch detector is not running, set hitch threshold in UNET settings to enable it"));
+                return;
+            }
+
+            Ar.Logf(TEXT("Managed hitches: %d since start, threshold %.1f ms, last %d kept"), NumHitches, ThresholdSeconds * 1000.0, History.Num());
+
+            if (History.Num() == 0) {
+                return;
+            }
+
+            double TotalSeconds = 0.0;
+            const FHitch* Worst = &History[0];
+            TArray<FCallStats> Calls;
+
+            for (auto& Hitch : History) {
+                TotalSeconds += Hitch.ManagedSeconds;
+                Worst = Hitch.ManagedSeconds > Worst->ManagedSeconds ? &Hitch : Worst;
+
+                for (auto& Call : Hitch.TopCalls) {
+                    auto Stats = Calls.FindByPredicate([&](const FCallStats& Other) { return Other.Name == Call.Name; });
+
+                    if (!Stats) {
+                        Stats = &Calls.Add_GetRef({ Call.Name, 0.0, 0 });
+                    }
+
+                    Stats->Seconds += Call.Seconds;
+                    Stats->Count += Call.Count;
+                }
+            }
+
+            Calls.Sort([](const FCallStats& Lhs, const FCallStats& Rhs) { return Lhs.Seconds > Rhs.Seconds; });
+
+            Ar.Logf(TEXT("  Average: %.2f ms in managed code"), TotalSeconds * 1000.0 / History.Num());
+            Ar.Logf(TEXT("  Worst:   %.2f ms of %.2f ms frame %llu"), Worst->ManagedSeconds * 1000.0, Worst->FrameSeconds * 1000.0, Worst->FrameNumber);
+            Ar.Logf(TEXT("  Calls:   %s"), *DescribeCalls(TArrayView<const FCallStats>(Calls).Left(5)));
+
+            // Oldest first, ring buffer starts at the next slot once it is full
+            auto First = History.Num() < MaxHistory ? 0 : NextHistoryIndex;
+
+            for (int32 i = 0; i < History.Num(); i++) {
+                auto& Hitch = History[(First + i) % History.Num()];
+
+                Ar.Logf(TEXT("  Frame %llu: %.2f ms managed of %.2f ms, %s%s%s. %s"),
+                    Hitch.FrameNumber, Hitch.ManagedSeconds * 1000.0, Hitch.FrameSeconds * 1000.0,
+                    *DescribeCalls(Hitch.TopCalls),
+                    Hitch.StuckCalls.IsEmpty() ? TEXT("") : TEXT(", stuck in "), *Hitch.StuckCalls,
+                    *DescribeRuntimeDelta(Hitch.RuntimeDelta));
+            }
+        }
+    };
+
+    FHitchDetector HitchDetector;
+}
+
+UNET::FManagedCallScope::FManagedCallScope(FName Name) :
+    bIsTracked(HitchDetector.bIsActive.load(std::memory_order_relaxed) && IsInGameThread()) {
+    if (bIsTracked) {
+        HitchDetector.EnterCall(Name);
+    }
+}
+
+UNET::FManagedCallScope::~FManagedCallScope() {
+    if (bIsTracked) {
+        HitchDetector.LeaveCall();
+    }
+}
+
+void UNET::StartHitchDetector(float ThresholdMs) {
+    HitchDetector.Start(ThresholdMs);
+}
+
+void UNET::StopHitchDetector() {
+    HitchDetector.Stop();
+}
+
+void UNET::ReportHitchSummary(FOutputDevice& Ar) {
+    HitchDetector.Report(Ar);
+}
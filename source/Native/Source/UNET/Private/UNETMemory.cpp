@@ -0,0 +1,196 @@
+#include "UNETMemory.h"
+
+#include <cstddef>
+
+#include "Delegates.h"
+#include "LogUNET.h"
+
+LLM_DEFINE_TAG(UNET_Managed);
+LLM_DEFINE_TAG(UNET_Interop);
+
+namespace {
+
+    struct FPluginMemoryReport {
+        FOutputDevice* Ar;
+        int64 TotalImageBytes;
+    };
+
+    void __cdecl ReportPluginMemory(void* Context, const TCHAR* PluginName, int32 NameLength, int64 ImageBytes, int32 NumAssemblies) {
+        auto Report = (FPluginMemoryReport*)Context;
+
+        Report->Ar->Logf(TEXT("  %-40.*s %10.2f KB (%d assemblies)"), NameLength, PluginName, ImageBytes / 1024.0, NumAssemblies);
+        Report->TotalImageBytes += ImageBytes;
+    }
+
+    double ToMegabytes(int64 Bytes) {
+        return Bytes / (1024.0 * 1024.0);
+    }
+
+    //   Note: Arena is reset on game thread at the end of frame, and allocations from other threads
+    //   could outlive it or race with reset, so it is used only by game thread and needs no synchronization.
+    //   Allocations that don't fit are served by FMalloc and freed on the next reset.
+    /**
+     *   Linear allocator which memory is reused every frame.
+     */
+    class FFrameArena {
+
+        uint8* Memory = nullptr;
+        int64 Capacity = 0;
+
+        int64 Offset = 0;
+
+        TArray<void*> Overflow;
+
+        int64 PeakBytes = 0;
+        int64 OverflowBytes = 0;
+
+    public:
+
+        void Initialize(int64 CapacityBytes) {
+            LLM_SCOPE_BYTAG(UNET_Interop);
+
+            Release();
+
+            Capacity = CapacityBytes;
+            Memory = Capacity > 0 ? (uint8*)FMemory::Malloc(Capacity, PLATFORM_CACHE_LINE_SIZE) : nullptr;
+        }
+
+        void Release() {
+            Reset();
+
+            FMemory::Free(Memory);
+            Memory = nullptr;
+            Capacity = 0;
+        }
+
+        void* Allocate(SIZE_T Size, uint32 Alignment) {
+            Alignment = FMath::Max<uint32>(Alignment, alignof(std::max_align_t));
+
+            if (Memory) {
+                auto Start = Align(Memory + Offset, Alignment) - Memory;
+
+                if (Start + (int64)Size <= Capacity) {
+                    Offset = Start + Size;
+                    return Memory + Start;
+                }
+            }
+
+            LLM_SCOPE_BYTAG(UNET_Interop);
+
+            auto Result = FMemory::Malloc(Size, Alignment);
+
+            Overflow.Add(Result);
+            OverflowBytes += Size;
+
+            return Result;
+        }
+
+        void Reset() {
+            auto UsedBytes = Offset;
+            Offset = 0;
+
+            PeakBytes = FMath::Max(PeakBytes, UsedBytes + OverflowBytes);
+
+            if (Overflow.Num() > 0) {
+                UE_LOG(LogUNET, Verbose, TEXT("Frame arena overflowed by %lld bytes in %d allocations"), OverflowBytes, Overflow.Num());
+            }
+
+            for (auto Allocation : Overflow) {
+                FMemory::Free(Allocation);
+            }
+
+            Overflow.Reset();
+            OverflowBytes = 0;
+        }
+
+        int64 GetCapacity() const {
+            return Capacity;
+        }
+
+        int64 GetPeakBytes() const {
+            return PeakBytes;
+        }
+    };
+
+    FFrameArena FrameArena;
+}
+
+void* UNET::Malloc(SIZE_T Size, uint32 Alignment) {
+    LLM_SCOPE_BYTAG(UNET_Interop);
+    return FMemory::Malloc(Size, Alignment);
+}
+
+void* UNET::Realloc(void* Original, SIZE_T Size, uint32 Alignment) {
+    LLM_SCOPE_BYTAG(UNET_Interop);
+    return FMemory::Realloc(Original, Size, Alignment);
+}
+
+void UNET::Free(void* Original) {
+    FMemory::Free(Original);
+}
+
+void* UNET::FrameAlloc(SIZE_T Size, uint32 Alignment) {
+    checkf(IsInGameThread(), TEXT("Frame arena is reset on game thread, other threads must allocate with EngineMemory.Alloc"));
+
+    return FrameArena.Allocate(Size, Alignment);
+}
+
+void UNET::InitializeFrameArena(int64 CapacityBytes) {
+    FrameArena.Initialize(CapacityBytes);
+}
+
+void UNET::ResetFrameArena() {
+    FrameArena.Reset();
+}
+
+void UNET::ReleaseFrameArena() {
+    FrameArena.Release();
+}
+
+void UNET::ReportManagedMemory(FOutputDevice& Ar) {
+    if (!UNET::PluginLoaderDelegates.GetMemoryInfo) {
+        Ar.Logf(TEXT("UNET Runtime is not loaded"));
+        return;
+    }
+
+    FManagedMemoryInfo Info = {};
+    FPluginMemoryReport PluginReport = { &Ar, 0 };
+
+    Ar.Logf(TEXT("Managed plugins (size of loaded assembly images, not heap usage):"));
+    UNET::PluginLoaderDelegates.GetMemoryInfo(&Info, &PluginReport, &ReportPluginMemory);
+    Ar.Logf(TEXT("  Total image size: %.2f MB"), ToMegabytes(PluginReport.TotalImageBytes));
+
+    Ar.Logf(TEXT("Managed heap (as of GC #%lld):"), Info.GCIndex);
+    Ar.Logf(TEXT("  Heap size:     %10.2f MB"), ToMegabytes(Info.HeapSizeBytes));
+    Ar.Logf(TEXT("  Committed:     %10.2f MB"), ToMegabytes(Info.CommittedBytes));
+    Ar.Logf(TEXT("  Fragmented:    %10.2f MB"), ToMegabytes(Info.FragmentedBytes));
+
+    for (int32 Generation = 0; Generation < UE_ARRAY_COUNT(Info.GenerationSizeBytes); Generation++) {
+        Ar.Logf(TEXT("  Gen %d:         %10.2f MB"), Generation, ToMegabytes(Info.GenerationSizeBytes[Generation]));
+    }
+
+    Ar.Logf(TEXT("  LOH:           %10.2f MB"), ToMegabytes(Info.LargeObjectHeapSizeBytes));
+    Ar.Logf(TEXT("  POH:           %10.2f MB"), ToMegabytes(Info.PinnedObjectHeapSizeBytes));
+    Ar.Logf(TEXT("  Pinned objects: %lld"), Info.PinnedObjectsCount);
+
+    Ar.Logf(TEXT("Interop memory (FMalloc, LLM tag UNET_Interop):"));
+    Ar.Logf(TEXT("  Frame arena:   %10.2f MB (peak %.2f MB)"), ToMegabytes(FrameArena.GetCapacity()), ToMegabytes(FrameArena.GetPeakBytes()));
+}
+
+void UNET::UpdateManagedMemoryStats() {
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    if (!FLowLevelMemTracker::IsEnabled() || !UNET::PluginLoaderDelegates.GetMemoryInfo) {
+        return;
+    }
+
+    FManagedMemoryInfo Info = {};
+    UNET::PluginLoaderDelegates.GetMemoryInfo(&Info, nullptr, nullptr);
+
+    FLowLevelMemTracker::Get().SetTagAmountForTracker(
+        ELLMTracker::Default,
+        LLMTagDeclaration_UNET_Managed.GetUniqueName(),
+        ELLMTagSet::None,
+        Info.CommittedBytes,
+        true);
+#endif
+}
@@ -0,0 +1,30 @@
+#include "UNETNativeAOTRuntime.h"
+
+bool UNET::NativeAOTRuntime::Load(const FUNETRuntimePaths& Paths) {
+    if (IsLoaded()) {
+        return true;
+    }
+
+    auto LibraryHandle = FPlatformProcess::GetDllHandle(*Paths.NativeAOTLibraryPath);
+
+    if (!LibraryHandle) {
+        UE_LOG(LogUNET, Error, TEXT("Failed to load UNET NativeAOT library %s"), *Paths.NativeAOTLibraryPath);
+        return false;
+    }
+
+    auto Initialize = (RuntimeInitializer)FPlatformProcess::GetDllExport(LibraryHandle, EntryPoint);
+
+    if (!Initialize) {
+        UE_LOG(LogUNET, Error, TEXT("%s is not exported by %s, make sure it is published from UNET.NativeAOT project"), EntryPoint, *Paths.NativeAOTLibraryPath);
+
+        // Runtime inside of the library is not started yet, so it is still safe to free it
+        FPlatformProcess::FreeDllHandle(LibraryHandle);
+        return false;
+    }
+
+    Handle = LibraryHandle;
+    Initialize(*Paths.ManagedPluginsPath, Paths.ManagedPluginsPath.Len(), &UNET::NativeDelegates, &UNET::PluginLoaderDelegates);
+
+    UE_LOG(LogUNET, Display, TEXT("UNET NativeAOT library is loaded from %s"), *Paths.NativeAOTLibraryPath);
+    return true;
+}
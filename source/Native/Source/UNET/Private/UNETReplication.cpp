@@ -0,0 +1,32 @@
+#include <Net/Core/PushModel/PushModel.h>
+
+#include "Delegates.h"
+#include "LogUNET.h"
+
+/**
+* Called by C# code once per replicated property, the index is stable until class is replaced by hot reload
+*/
+int32 UNET::GetRepIndex(UClass* Class, const TCHAR* PropertyName, int32 NameLength) {
+    auto Property = FindFProperty<FProperty>(Class, FName(NameLength, PropertyName));
+
+    if (!Property || !Property->HasAnyPropertyFlags(CPF_Net)) {
+        UE_LOG(LogUNET, Warning, TEXT("Class %s has no replicated property %.*s"), *Class->GetName(), NameLength, PropertyName);
+        return INDEX_NONE;
+    }
+
+    // RepIndex is assigned when the first object of class is replicated, push model may be used before that
+    Class->SetUpRuntimeReplicationData();
+
+    return Property->RepIndex;
+}
+
+/**
+* Called by C# code when push based property is changed, so replication doesn't need to compare it
+*/
+void UNET::MarkPropertyDirty(UObject* Object, int32 RepIndex) {
+#if WITH_PUSH_MODEL
+    if (RepIndex != INDEX_NONE) {
+        MARK_PROPERTY_DIRTY_UNSAFE(Object, RepIndex);
+    }
+#endif
+}
@@ -1,16 +1,33 @@
 #include "UNETRuntime.h"
 
-void UNET::Runtime::Load(const HostFXR& Host, const UUNETSettings* Settings) {
-    auto ConfigPath = Settings->GetUNETLoaderConfigPath(),
-        AssemblyPath = Settings->GetUNETLoaderLibraryPath(),
-        ManagedPluginsPath = Settings->GetManagedPluginsPath();
+void UNET::Runtime::Load(const HostFXR& Host, const UUNETSettings* Settings, const FUNETRuntimePaths& Paths) {
+    if (IsInitialized()) {
+        bIsActive = true;
+        return;
+    }
 
-    Handle = Host.InitForRuntimeConfig(ConfigPath);
-    auto Initialize = (Initializer)Host.LoadRuntimeAndGetFunctionPointer(Handle, AssemblyPath, Settings->EntryType, Settings->EntryMethod);
-    Initialize(*ManagedPluginsPath, ManagedPluginsPath.Len(), &UNET::NativeDelegates, &UNET::PluginLoaderDelegates);
+    if (Settings->RuntimeBackend == EUNETRuntimeBackend::NativeAOT) {
+        bIsActive = NativeAOT.Load(Paths);
+        return;
+    }
+
+    Handle = Host.InitForRuntimeConfig(Paths.LoaderConfigPath);
+    auto Initialize = (Initializer)Host.LoadRuntimeAndGetFunctionPointer(Handle, Paths.LoaderLibraryPath, Settings->EntryType, Settings->EntryMethod);
+    Initialize(*Paths.ManagedPluginsPath, Paths.ManagedPluginsPath.Len(), &UNET::NativeDelegates, &UNET::PluginLoaderDelegates);
+
+    bIsActive = true;
+}
+
+void UNET::Runtime::Unload() {
+    bIsActive = false;
 }
 
-void UNET::Runtime::Unload(const HostFXR& Host) {
-    Host.CloseRuntime(Handle);
-    Handle = nullptr;
-}
\ No newline at end of file
+void UNET::Runtime::Shutdown(const HostFXR& Host) {
+    bIsActive = false;
+
+    // NativeAOT library has no way to be shut down, it is released with the process
+    if (Handle) {
+        Host.CloseRuntime(Handle);
+        Handle = nullptr;
+    }
+}
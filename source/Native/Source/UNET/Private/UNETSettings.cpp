@@ -1,5 +1,7 @@
 #include "UNETSettings.h"
 
+#include <Misc/PathViews.h>
+
 #define LOCTEXT_NAMESPACE "UNET"
 
 #if WITH_EDITOR
@@ -12,6 +14,13 @@ bool UUNETSettings::CanEditChange(const FProperty* InProperty) const {
         bCanEditChange &= FPaths::DirectoryExists(GetHostfxrPath()) & !GetDotnetInstallations().IsEmpty();
     }
 
+    // NativeAOT library contains its own runtime, so installed .NET is not used
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(UUNETSettings, DotNetLocation) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(UUNETSettings, DotNetVersion) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(UUNETSettings, bAllowDotNetPreview)) {
+        bCanEditChange &= RuntimeBackend == EUNETRuntimeBackend::HostFXR;
+    }
+
     return bCanEditChange;
 }
 
@@ -57,15 +66,99 @@ UUNETSettings::UUNETSettings(const FObjectInitializer& ObjectInitializer) :
     SectionName = TEXT("UNET");
 
     // Initialize default values
+    RuntimeBackend = EUNETRuntimeBackend::HostFXR;
     bAllowDotNetPreview = false;
+    FrameArenaSizeKB = 1024;
+    ManagedThreadPoolMinThreads = 0;
+    ManagedThreadPoolMaxThreads = 0;
+    bBulkSerializeManagedProperties = false;
+    ManagedTraceEvents = (int32)(EUNETManagedTraceEvents::GC | EUNETManagedTraceEvents::Jit | EUNETManagedTraceEvents::Exceptions | EUNETManagedTraceEvents::ThreadPool);
+    ManagedHitchThresholdMs = 0.0f;
     DotNetLocation.Path = GetDotnetInstallDir();
 
     LoadConfig();
+
+#if WITH_EDITOR
+    // Available installations are used only by settings editor, so packaged game doesn't walk file system at all
     UpdateDotnetInstallations();
+#endif
+}
+
+TArray<FString> UUNETSettings::FindDotnetInstallations(const FString& HostDir, bool bAllowPreview) {
+    TArray<TPair<FVersion, FString>> Found;
+
+    auto AddDirectory = [&](const TCHAR* Path, bool bIsDir) -> bool {
+        if (!bIsDir) {
+            return true;
+        }
+
+        auto DirName = FPathViews::GetCleanFilename(Path);
+
+        FVersion FoundVersion;
+
+        if (!FVersion::TryParse(DirName, FoundVersion) ||
+            (FoundVersion.Major < MinimalDotNetVersion) ||
+            (FoundVersion.bIsPreview && !bAllowPreview)) {
+            return true;
+        }
+
+        Found.Emplace(FoundVersion, FString(DirName));
+
+        return true;
+    };
+
+    FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*HostDir, AddDirectory);
+
+    Found.Sort([](auto& Lhs, auto& Rhs) { return Lhs.Key < Rhs.Key; });
+
+    TArray<FString> Installations;
+    Installations.Reserve(Found.Num());
+
+    for (auto& Installation : Found) {
+        Installations.Add(MoveTemp(Installation.Value));
+    }
+
+    return Installations;
+}
+
+#if WITH_EDITOR
+void UUNETSettings::UpdateDotnetInstallations() {
+    static const TCHAR* CacheSection = TEXT("UNET.DotNetInstallations");
+
+    AvailableDotNetInstallations.Empty();
+
+    auto HostDir = GetHostfxrPath();
+    auto StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*HostDir);
+
+    if (!StatData.bIsValid || !StatData.bIsDirectory) {
+        return;
+    }
+
+    // Installing or removing .NET version changes modification time of host/fxr directory
+    auto CacheKey = FString::Printf(TEXT("%s|%lld|%d"), *HostDir, StatData.ModificationTime.GetTicks(), bAllowDotNetPreview ? 1 : 0);
+
+    FString CachedKey;
+
+    if (GConfig->GetString(CacheSection, TEXT("Key"), CachedKey, GEditorPerProjectIni) && CachedKey == CacheKey) {
+        GConfig->GetArray(CacheSection, TEXT("Versions"), AvailableDotNetInstallations, GEditorPerProjectIni);
+        return;
+    }
+
+    AvailableDotNetInstallations = FindDotnetInstallations(HostDir, bAllowDotNetPreview);
+
+    GConfig->SetString(CacheSection, TEXT("Key"), *CacheKey, GEditorPerProjectIni);
+    GConfig->SetArray(CacheSection, TEXT("Versions"), AvailableDotNetInstallations, GEditorPerProjectIni);
 }
+#endif
+
+bool UUNETSettings::Validate(FUNETRuntimePaths& OutPaths) const {
+    OutPaths.ManagedPluginsPath = GetManagedPluginsPath();
+    OutPaths.HostfxrLibPath = GetHostfxrLibPath();
+    OutPaths.LoaderLibraryPath = GetUNETLoaderLibraryPath();
+    OutPaths.LoaderConfigPath = GetUNETLoaderConfigPath();
+    OutPaths.NativeAOTLibraryPath = GetNativeAOTLibraryPath();
 
-bool UUNETSettings::Validate() const {
-    auto managedPluginsPath = GetManagedPluginsPath();
+    auto& managedPluginsPath = OutPaths.ManagedPluginsPath;
     if (!FPaths::DirectoryExists(managedPluginsPath)) {
 
         UE_LOG(LogUNET, Warning, TEXT("Failed to locate directory for managed plugins"));
@@ -81,17 +174,47 @@ bool UUNETSettings::Validate() const {
         }
     }
 
-    if (!FPaths::FileExists(GetHostfxrLibPath())) {
+    if (RuntimeBackend == EUNETRuntimeBackend::NativeAOT) {
+        if (!FPaths::FileExists(OutPaths.NativeAOTLibraryPath)) {
+            UE_LOG(LogUNET, Error, TEXT("Failed to locate UNET NativeAOT library: %s"), *OutPaths.NativeAOTLibraryPath);
+            return false;
+        }
+
+        return true;
+    }
+
+#if !WITH_EDITOR
+    // Runtime packaged with the game is preferred over the one configured in editor
+    auto HostDir = FPaths::DirectoryExists(GetEmbeddedHostfxrPath()) ? GetEmbeddedHostfxrPath() : GetHostfxrPath();
+    OutPaths.HostfxrLibPath = GetHostfxrLibPath(HostDir, DotNetVersion);
+
+    if (!FPaths::FileExists(OutPaths.HostfxrLibPath)) {
+        // Packaged runtime can have another version than editor had, so the newest one is used instead
+        auto Installations = FindDotnetInstallations(HostDir, bAllowDotNetPreview);
+
+        if (!Installations.IsEmpty()) {
+            UE_LOG(LogUNET, Log, TEXT(".NET %s is not found, .NET %s will be used instead"), *DotNetVersion, *Installations.Last());
+            OutPaths.HostfxrLibPath = GetHostfxrLibPath(HostDir, Installations.Last());
+        }
+    }
+
+    if (FPaths::FileExists(GetPackagedLoaderConfigPath())) {
+        OutPaths.LoaderConfigPath = GetPackagedLoaderConfigPath();
+        UE_LOG(LogUNET, Display, TEXT("Packaged UNET runtime config is used: %s"), *OutPaths.LoaderConfigPath);
+    }
+#endif
+
+    if (!FPaths::FileExists(OutPaths.HostfxrLibPath)) {
         UE_LOG(LogUNET, Error, TEXT("Failed to locate .NET host"));
         return false;
     }
 
-    if (!FPaths::FileExists(GetUNETLoaderLibraryPath())) {
+    if (!FPaths::FileExists(OutPaths.LoaderLibraryPath)) {
         UE_LOG(LogUNET, Error, TEXT("Failed to locate UNET Plugin Loader"));
         return false;
     }
 
-    if (!FPaths::FileExists(GetUNETLoaderConfigPath())) {
+    if (!FPaths::FileExists(OutPaths.LoaderConfigPath)) {
         UE_LOG(LogUNET, Error, TEXT("Failed to locate UNET Plugin Loader Config"));
         return false;
     }
@@ -0,0 +1,48 @@
+#include "UNETTasks.h"
+
+#include <Async/ParallelFor.h>
+#include <Async/TaskGraphInterfaces.h>
+#include <Tasks/Task.h>
+
+#include "Delegates.h"
+
+namespace {
+
+    // More batches than workers let fast workers take work of slow ones, while each batch is still a single managed call
+    constexpr int32 BatchesPerWorker = 4;
+}
+
+/**
+* Called by C# code, elements are split into batches, so managed code is entered once per batch instead of once per element
+*/
+void UNET::ParallelFor(int32 Num, int32 MinBatchSize, FManagedParallelForCallback Callback, void* Context) {
+    if (Num <= 0) {
+        return;
+    }
+
+    auto MaxBatches = (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) * BatchesPerWorker;
+    auto NumBatches = FMath::Clamp(FMath::DivideAndRoundUp(Num, FMath::Max(MinBatchSize, 1)), 1, MaxBatches);
+    auto BatchSize = FMath::DivideAndRoundUp(Num, NumBatches);
+
+    ::ParallelFor(TEXT("UNET.ParallelFor"), NumBatches, 1, [=](int32 BatchIndex) {
+        auto Start = BatchIndex * BatchSize;
+        auto End = FMath::Min(Start + BatchSize, Num);
+
+        if (Start < End) {
+            // Batches run by workers don't stall the frame, so only those on game thread are tracked
+            static const FName CallName = TEXT("ParallelFor");
+            FManagedCallScope CallScope(CallName);
+
+            Callback(Context, Start, End);
+        }
+    });
+}
+
+/**
+* Called by C# task scheduler for each queued task
+*/
+void UNET::LaunchTask(FManagedTaskCallback Callback, void* Context) {
+    UE::Tasks::Launch(TEXT("UNET.Task"), [Callback, Context] {
+        Callback(Context);
+    });
+}
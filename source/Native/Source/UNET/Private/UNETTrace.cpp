@@ -0,0 +1,100 @@
+#include "UNETTrace.h"
+
+#include <ProfilingDebugging/CountersTrace.h>
+#include <ProfilingDebugging/MiscTrace.h>
+
+#include "Delegates.h"
+
+UE_TRACE_CHANNEL_DEFINE(UNETManagedChannel);
+
+// Exact timing of runtime events, UNETTraceAnalysis module turns them into timing events of Insights.
+// Counters and bookmarks below are placed when event reaches native side
+UE_TRACE_EVENT_BEGIN(UNETManaged, GCPause)
+    UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+    UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+    UE_TRACE_EVENT_FIELD(int32, Generation)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(UNETManaged, JitCompilation)
+    UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+    UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Method)
+UE_TRACE_EVENT_END()
+
+TRACE_DECLARE_FLOAT_COUNTER(UNET_GCPause, TEXT("UNET/Managed/GC Pause (ms)"));
+TRACE_DECLARE_INT_COUNTER(UNET_GCCount, TEXT("UNET/Managed/GC Count"));
+TRACE_DECLARE_INT_COUNTER(UNET_JitCount, TEXT("UNET/Managed/JIT Compiled Methods"));
+TRACE_DECLARE_FLOAT_COUNTER(UNET_JitTime, TEXT("UNET/Managed/JIT Total Time (ms)"));
+TRACE_DECLARE_INT_COUNTER(UNET_ExceptionCount, TEXT("UNET/Managed/Exceptions"));
+TRACE_DECLARE_INT_COUNTER(UNET_ThreadPoolWorkers, TEXT("UNET/Managed/Thread Pool Workers"));
+
+namespace {
+
+    // Gen 0 and gen 1 collections are too frequent to be bookmarked, they are visible via counters
+    constexpr int32 MinBookmarkedGeneration = 2;
+
+    void ToCycles(const UNET::FManagedTraceEvent* Event, uint64& OutStartCycle, uint64& OutEndCycle) {
+        auto Now = FPlatformTime::Cycles64();
+        auto SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+
+        OutEndCycle = Now - FMath::Min<uint64>(Now, (uint64)(Event->SecondsAgo / SecondsPerCycle));
+        OutStartCycle = OutEndCycle - FMath::Min<uint64>(OutEndCycle, (uint64)(Event->DurationSeconds / SecondsPerCycle));
+    }
+}
+
+bool UNET::IsManagedTraceEnabled() {
+    return UE_TRACE_CHANNELEXPR_IS_ENABLED(UNETManagedChannel);
+}
+
+/**
+* Called from EventPipe dispatch thread, so it must not touch UObjects
+*/
+void UNET::TraceEvent(const FManagedTraceEvent* Event) {
+    if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(UNETManagedChannel)) {
+        return;
+    }
+
+    uint64 StartCycle, EndCycle;
+    ToCycles(Event, StartCycle, EndCycle);
+
+    switch (Event->Type) {
+    case EManagedTraceEvent::GCPause:
+        UE_TRACE_LOG(UNETManaged, GCPause, UNETManagedChannel)
+            << GCPause.StartCycle(StartCycle)
+            << GCPause.EndCycle(EndCycle)
+            << GCPause.Generation(Event->Value);
+
+        TRACE_COUNTER_SET(UNET_GCPause, Event->DurationSeconds * 1000.0);
+        TRACE_COUNTER_INCREMENT(UNET_GCCount);
+
+        if (Event->Value >= MinBookmarkedGeneration) {
+            TRACE_BOOKMARK(TEXT("Managed GC (gen %d): %.2f ms"), Event->Value, Event->DurationSeconds * 1000.0);
+        }
+        break;
+
+    case EManagedTraceEvent::JitCompilation:
+        UE_TRACE_LOG(UNETManaged, JitCompilation, UNETManagedChannel)
+            << JitCompilation.StartCycle(StartCycle)
+            << JitCompilation.EndCycle(EndCycle)
+            << JitCompilation.Method(Event->Name, Event->NameLength);
+
+        TRACE_COUNTER_INCREMENT(UNET_JitCount);
+        TRACE_COUNTER_ADD(UNET_JitTime, Event->DurationSeconds * 1000.0);
+        break;
+
+    case EManagedTraceEvent::Exception: {
+        FString ExceptionType(Event->NameLength, Event->Name);
+
+        TRACE_COUNTER_INCREMENT(UNET_ExceptionCount);
+        TRACE_BOOKMARK(TEXT("Managed exception: %s"), *ExceptionType);
+        break;
+    }
+
+    case EManagedTraceEvent::ThreadPoolWorkers:
+        TRACE_COUNTER_SET(UNET_ThreadPoolWorkers, Event->Value);
+        break;
+
+    default:
+        break;
+    }
+}
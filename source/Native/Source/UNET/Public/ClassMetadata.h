@@ -0,0 +1,126 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/UObjectGlobals.h>
+
+namespace UNET {
+
+    //   Note: Written by UNET source generator next to plugin as <Plugin>.unetmeta, so layout here is a file format.
+    //   All offsets are in bytes from the start of the blob unless said otherwise, values are little-endian.
+    /**
+     *   Header of precompiled class metadata of a single plugin.
+     */
+    struct FClassMetadataHeader {
+        static constexpr uint32 ExpectedMagic = 0x444D4E55; // "UNMD"
+        static constexpr uint16 CurrentVersion = 1;
+
+        uint32 Magic;
+        uint16 Version;
+        uint16 HeaderSize;
+
+        uint32 NumClasses;
+        uint32 NumProperties;
+
+        // FClassMetadataRecord[NumClasses], parents are always written before their children
+        uint32 ClassesOffset;
+        // FPropertyMetadataRecord[NumProperties], properties of each class are stored in a row
+        uint32 PropertiesOffset;
+
+        // Null-terminated strings, names used by UE as TCHAR are UTF-16, property names are UTF-8
+        uint32 StringsOffset;
+        uint32 StringsSize;
+
+        // Default values of classes, each one is laid out the same way as properties of its class
+        uint32 DataOffset;
+        uint32 DataSize;
+    };
+
+    /**
+     *   Class declared by plugin. Layout of its own properties is resolved at build time relative to the start of its block.
+     */
+    struct FClassMetadataRecord {
+        static constexpr uint32 InvalidOffset = MAX_uint32;
+
+        // Offsets in string pool
+        uint32 PackageName;
+        uint32 ClassName;
+        uint32 ParentName;
+        uint32 ConfigName;
+
+        // Index of parent in the same blob, or INDEX_NONE when parent is native class
+        int32 ParentIndex;
+        uint32 ClassFlags;
+        uint64 CastFlags;
+
+        uint32 FirstProperty;
+        uint32 NumProperties;
+
+        // Size and alignment of properties declared by class itself, the block starts at aligned size of parent
+        uint32 LayoutSize;
+        uint32 LayoutAlignment;
+
+        // Offset in data pool of LayoutSize bytes, or InvalidOffset when all values are zero
+        uint32 DefaultValues;
+        uint32 Reserved;
+    };
+
+    /**
+     *   Property of managed class.
+     */
+    struct FPropertyMetadataRecord {
+        // Replication settings are packed into unused bits of GenFlags, so older blobs get default ones
+        static constexpr uint32 GenFlagsMask = 0xFF;
+        static constexpr uint32 ConditionShift = 8;
+        static constexpr uint32 RepNotifyConditionShift = 16;
+        static constexpr uint32 PushBasedFlag = 1u << 24;
+
+        // Offsets in string pool, RepNotifyName can be InvalidOffset
+        uint32 Name;
+        uint32 RepNotifyName;
+
+        uint64 PropertyFlags;
+        // EPropertyGenFlags in bits 0-7, ELifetimeCondition in bits 8-15, ELifetimeRepNotifyCondition in bits 16-23, push model flag in bit 24
+        uint32 GenFlags;
+        uint32 ObjectFlags;
+        int32 ArrayDim;
+
+        // Relative to the start of class properties block
+        uint32 Offset;
+    };
+
+    static_assert(sizeof(FClassMetadataHeader) == 40, "Size of FClassMetadataHeader is a part of file format");
+    static_assert(sizeof(FClassMetadataRecord) == 56, "Size of FClassMetadataRecord is a part of file format");
+    static_assert(sizeof(FPropertyMetadataRecord) == 32, "Size of FPropertyMetadataRecord is a part of file format");
+
+    /**
+     *   Registers classes from precompiled metadata without managed FManagedClassInfo.
+     *   Blob is mapped into memory when platform allows it and stays alive until all its classes are reloaded, because UE keeps pointers to its names.
+     */
+    class ClassMetadata {
+
+    public:
+
+        /**
+         *   Property of class declared from native code, only types supported by precompiled metadata can be used.
+         */
+        struct FPropertyDeclaration {
+            const char* Name;
+            UECodeGen_Private::EPropertyGenFlags Type;
+            // Relative to the start of class properties block, must be aligned to size of property
+            uint32 Offset;
+            EPropertyFlags Flags = CPF_None;
+            const char* RepNotifyName = nullptr;
+            // ELifetimeCondition
+            uint8 Condition = 0;
+        };
+
+        // Blob is validated as a whole before anything is registered, so on failure managed metadata can be used instead.
+        // Returns offset of the first own property of each class in blob order, valid until next call, or nullptr on failure.
+        // Dirty bits of class follow its properties at offset aligned to 8 bytes.
+        static const int32* Register(const FString& Path, int32& OutNumClasses);
+        static const int32* Register(TArray<uint8>&& Data, int32& OutNumClasses);
+
+        // Writes blob of a single class, so benchmarks and tests can declare managed classes without managed plugin
+        static TArray<uint8> Write(const TCHAR* PackageName, const TCHAR* ClassName, const TCHAR* ParentName, TArrayView<const FPropertyDeclaration> Properties);
+    };
+}
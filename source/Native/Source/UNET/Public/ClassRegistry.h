@@ -0,0 +1,77 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "ManagedClassInfo.h"
+
+namespace UNET {
+
+    /**
+     *   Keeps track of classes registered by managed plugins.
+     *   UClasses can't be destroyed while their instances are alive, so they outlive plugins and are reused on reload.
+     */
+    class ClassRegistry {
+
+        struct FEntry {
+            // Owned by managed plugin and becomes invalid when plugin is unloaded
+            FManagedClassInfo* Info = nullptr;
+            UClass* Class = nullptr;
+
+            // Layout version of Info, fields it doesn't have are defaulted
+            EManagedClassInfoVersion Version = EManagedClassInfoVersion::Latest;
+
+            // Default values of properties declared by class itself
+            TArray<uint8> DefaultValues;
+        };
+
+        static TMap<FName, FEntry> Entries;
+
+        // Classes declared by manifests of plugins loaded on demand, mapped to managed id of their plugin
+        static TMap<FName, int32> DeferredClasses;
+
+        static int32 NumRegistrations;
+        static double RegistrationSeconds;
+
+    public:
+
+        static void Add(FManagedClassInfo* Info, EManagedClassInfoVersion Version, TArray<uint8>&& DefaultValues, UClass* Class = nullptr);
+        static void SetClass(FManagedClassInfo* Info, UClass* Class);
+
+        static UClass* FindClass(FName ClassName);
+        static FManagedClassInfo* FindInfo(FName ClassName);
+        static const TArray<uint8>& GetDefaultValues(FName ClassName);
+        static EManagedClassInfoVersion GetVersion(FName ClassName);
+
+        // Forgets metadata of unloaded plugins, but keeps constructed classes for reuse
+        static void Reset();
+
+        static void AddDeferred(FName ClassName, int32 PluginId);
+
+        // Loads plugin that declared class in its manifest, if class is not registered yet.
+        // Returned class is allocated but may wait for ProcessNewlyLoadedUObjects to be constructed, nullptr when class is unknown
+        static UClass* LoadDeferredClass(FName ClassName);
+
+        static int32 NumDeferred() {
+            return DeferredClasses.Num();
+        }
+
+        static int32 Num() {
+            return Entries.Num();
+        }
+
+        // Construction of class is deferred by UE, so its time is added separately from registration
+        static void AddRegistrationTime(double Seconds, bool bIsNewRegistration = true) {
+            NumRegistrations += bIsNewRegistration ? 1 : 0;
+            RegistrationSeconds += Seconds;
+        }
+
+        // Count of RegisterNewClass calls since module startup
+        static int32 GetNumRegistrations() {
+            return NumRegistrations;
+        }
+
+        static double GetRegistrationSeconds() {
+            return RegistrationSeconds;
+        }
+    };
+}
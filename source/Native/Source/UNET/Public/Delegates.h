@@ -3,27 +3,103 @@
 #include <CoreMinimal.h>
 
 #include "UNETClass.h"
+#include "UNETMemory.h"
+#include "UNETBenchmark.h"
+#include "UNETDelegateHandler.h"
+#include "UNETTrace.h"
+#include "UNETFunctionCall.h"
+#include "UNETTasks.h"
+#include "UNETHostInfo.h"
+#include "UNETHitchDetector.h"
+#include "UNETCommandBuffer.h"
 
 UNET_API DECLARE_LOG_CATEGORY_EXTERN(LogUNETManaged, Log, All);
 
 namespace UNET {
 
-    static void LogManaged(ELogVerbosity::Type Level, TCHAR* Message);
-    static UClass* OuterRegisterInternal(FManagedClassInfo* Info);
-    static UClass* InnerRegisterInternal(FManagedClassInfo* Info);
-    static void RegisterNewClass(FManagedClassInfo* Info);
+    void LogManaged(ELogVerbosity::Type Level, TCHAR* Message);
+    UClass* OuterRegisterInternal(FManagedClassInfo* Info);
+    UClass* InnerRegisterInternal(FManagedClassInfo* Info);
+    void RegisterNewClass(FManagedClassInfo* Info, EManagedClassInfoVersion Version);
+    // Registers class which layout and default values are already resolved
+    void RegisterResolvedClass(FManagedClassInfo* Info, TArray<uint8>&& DefaultValues, EManagedClassInfoVersion Version);
+    const int32* RegisterClassMetadata(const TCHAR* Path, int32 PathLength, int32* OutNumClasses);
+    void Ping();
+    void GetHostInfo(FManagedHostInfo* OutInfo);
+    UUNETDelegateHandler* BindDelegate(UObject* Target, const TCHAR* DelegateName, int32 NameLength, FManagedDelegateCallback Callback, void* Handle,
+        const TCHAR* OwnerName, int32 OwnerNameLength);
+    void UnbindDelegate(UUNETDelegateHandler* Handler);
+    int32 QueryInstances(UClass* Class, UObject** OutObjects, void** OutPropertyBases, int32 Capacity);
+    void TraceEvent(const FManagedTraceEvent* Event);
+    void* Malloc(SIZE_T Size, uint32 Alignment);
+    void* Realloc(void* Original, SIZE_T Size, uint32 Alignment);
+    void Free(void* Original);
+    // Memory is valid until the end of current frame, can be called only on game thread
+    void* FrameAlloc(SIZE_T Size, uint32 Alignment);
+    bool ResolveFunction(const TCHAR* ClassName, int32 ClassNameLength, const TCHAR* FunctionName, int32 FunctionNameLength,
+        FManagedFunctionInfo* OutInfo, int32* OutParamOffsets, int32 Capacity);
+    void CallFunction(UObject* Object, UFunction* Function, void* Params);
+    // Returns when all elements are processed
+    void ParallelFor(int32 Num, int32 MinBatchSize, FManagedParallelForCallback Callback, void* Context);
+    void LaunchTask(FManagedTaskCallback Callback, void* Context);
+    int32 GetRepIndex(UClass* Class, const TCHAR* PropertyName, int32 NameLength);
+    void MarkPropertyDirty(UObject* Object, int32 RepIndex);
+    void RegisterDeferredClass(const TCHAR* ClassName, int32 NameLength, int32 PluginId);
+    // Object pointers at RefOffsets in Commands are replaced by FManagedObjectRef before the first command is executed
+    int32 ExecuteCommands(uint8* Commands, int32 Size, const int32* RefOffsets, int32 NumRefs, UObject** OutResults, int32 ResultsCapacity);
+    void UnbindOwnedDelegates(const TCHAR* OwnerName, int32 OwnerNameLength);
 
-    static const struct NativeDelegates {
+    // Passed to C# side, so order of fields must match UNET.NativeDelegates
+    struct NativeDelegates {
         void(__cdecl* _log)(ELogVerbosity::Type, TCHAR*) = &UNET::LogManaged;
         UClass* (__cdecl* _outerRegisterInternal)(FManagedClassInfo*) = &OuterRegisterInternal;
         UClass* (__cdecl* _innerRegisterInternal)(FManagedClassInfo*) = &InnerRegisterInternal;
-        void(__cdecl* _registerManagedClass)(FManagedClassInfo*) = &RegisterNewClass;
-    } NativeDelegates;
+        void(__cdecl* _registerManagedClass)(FManagedClassInfo*, EManagedClassInfoVersion) = &RegisterNewClass;
+        void(__cdecl* _ping)() = &Ping;
+        const int32* (__cdecl* _registerClassMetadata)(const TCHAR*, int32, int32*) = &RegisterClassMetadata;
+        UUNETDelegateHandler* (__cdecl* _bindDelegate)(UObject*, const TCHAR*, int32, FManagedDelegateCallback, void*, const TCHAR*, int32) = &BindDelegate;
+        void(__cdecl* _unbindDelegate)(UUNETDelegateHandler*) = &UnbindDelegate;
+        int32(__cdecl* _queryInstances)(UClass*, UObject**, void**, int32) = &QueryInstances;
+        void(__cdecl* _traceEvent)(const FManagedTraceEvent*) = &TraceEvent;
+        void* (__cdecl* _malloc)(SIZE_T, uint32) = &Malloc;
+        void* (__cdecl* _realloc)(void*, SIZE_T, uint32) = &Realloc;
+        void(__cdecl* _free)(void*) = &Free;
+        void* (__cdecl* _frameAlloc)(SIZE_T, uint32) = &FrameAlloc;
+        bool(__cdecl* _resolveFunction)(const TCHAR*, int32, const TCHAR*, int32, FManagedFunctionInfo*, int32*, int32) = &ResolveFunction;
+        void(__cdecl* _callFunction)(UObject*, UFunction*, void*) = &CallFunction;
+        void(__cdecl* _parallelFor)(int32, int32, FManagedParallelForCallback, void*) = &ParallelFor;
+        void(__cdecl* _launchTask)(FManagedTaskCallback, void*) = &LaunchTask;
+        void(__cdecl* _getHostInfo)(FManagedHostInfo*) = &GetHostInfo;
+        int32(__cdecl* _getRepIndex)(UClass*, const TCHAR*, int32) = &GetRepIndex;
+        void(__cdecl* _markPropertyDirty)(UObject*, int32) = &MarkPropertyDirty;
+        void(__cdecl* _registerDeferredClass)(const TCHAR*, int32, int32) = &RegisterDeferredClass;
+        int32(__cdecl* _executeCommands)(uint8*, int32, const int32*, int32, UObject**, int32) = &ExecuteCommands;
+        void(__cdecl* _unbindOwnedDelegates)(const TCHAR*, int32) = &UnbindOwnedDelegates;
+    };
 
     // Loaded on C# side
-    static struct PluginLoaderDelegates {
+    struct PluginLoaderDelegates {
         void(__cdecl* Load)();
         void(__cdecl* Unload)();
         void(__cdecl* Reload)();
-    } PluginLoaderDelegates;
+        void(__cdecl* GetMemoryInfo)(FManagedMemoryInfo* Info, void* Context, FManagedPluginMemoryCallback PluginCallback);
+        void(__cdecl* Ping)();
+        // Returns time of all iterations in seconds
+        double(__cdecl* RunBenchmark)(EManagedBenchmark Benchmark, int32 Iterations, UClass* ManagedClass, int32 NumProperties);
+        int32(__cdecl* GetPendingReloads)();
+        int32(__cdecl* ReloadPending)();
+        // Events is a mask of EUNETManagedTraceEvents
+        void(__cdecl* StartTraceSession)(int32 Events);
+        void(__cdecl* StopTraceSession)();
+        // Zero keeps value chosen by runtime
+        void(__cdecl* ConfigureThreadPool)(int32 MinThreads, int32 MaxThreads);
+        // Loads plugin which registration was deferred until one of its classes is requested
+        void(__cdecl* LoadDeferredPlugin)(int32 PluginId);
+        // Safe to call from any thread
+        void(__cdecl* GetRuntimeState)(FManagedRuntimeState* OutState);
+    };
+
+    // Single instances shared by all translation units, defined in Delegates.cpp
+    extern const struct NativeDelegates NativeDelegates;
+    extern struct PluginLoaderDelegates PluginLoaderDelegates;
 }
@@ -1,6 +1,47 @@
 #pragma once
 
 #include <UObject/UObjectGlobals.h>
+#include <UObject/CoreNetTypes.h>
+
+/**
+ *   Replication settings of managed property, used only when property has CPF_Net flag.
+ */
+struct FManagedReplicationParams {
+    // ELifetimeCondition
+    uint8 Condition;
+    // ELifetimeRepNotifyCondition
+    uint8 RepNotifyCondition;
+
+    // Property is marked dirty by managed code, so it isn't compared every net update
+    uint8 bIsPushBased;
+};
+
+/**
+ *   Property with RepNotify function is replicated even when metadata has only the function name, UE expects both flags then.
+ */
+inline EPropertyFlags GetReplicationFlags(EPropertyFlags Flags, const char* RepNotifyFuncUTF8) {
+    if (RepNotifyFuncUTF8 && *RepNotifyFuncUTF8) {
+        Flags |= CPF_Net | CPF_RepNotify;
+    }
+
+    return Flags;
+}
+
+/**
+ *   Layout versions of FManagedClassInfo. Fields are only appended, so struct of older generator is a prefix of the latest one.
+ *   Values are shared with UNET.ClassInfoVersion on C# side.
+ */
+enum class EManagedClassInfoVersion : int32 {
+    Initial,
+    // Adds DefaultValues
+    DefaultValues,
+    // Adds ReplicationParams
+    ReplicationParams,
+    // Adds DirtyMaskOffset
+    DirtyMask,
+
+    Latest = DirtyMask
+};
 
 //   Note: Created only on C# side and passed to C++ by pointer, so here it doesn't need a constructor.
 /**
@@ -9,7 +50,7 @@
 struct FManagedClassInfo : UECodeGen_Private::FClassParams {
 
 private:
-    void SetupProperties();
+    void SetupProperties(TArray<uint8>& OutDefaultValues, EManagedClassInfoVersion Version);
 
 public:
     EClassCastFlags CastFlags;
@@ -34,5 +75,47 @@ public:
     //Flag used to determine, whether this info is already registered in Unreal Engine
     uint8 IsRegistered;
 
-    void Initialize();
+    // Fields below exist only in structs of newer generators, they are accessed through getters that check version of the struct
+
+    // Default values of properties packed in declaration order, each one takes size of its property. Zeroed if nullptr
+    const uint8* DefaultValues;
+
+    // Replication settings of each property in PropertyArray, nullptr when replicated properties use defaults
+    const FManagedReplicationParams* ReplicationParams;
+
+    // Filled on registration, offset of dirty bits of own properties from the start of object or INDEX_NONE when class has no properties.
+    // Managed setters set bit with index of property in PropertyArray
+    int32 DirtyMaskOffset;
+
+    // Resolves parent class and layout of properties, default values are laid out the same way as properties after parent ones
+    void Initialize(TArray<uint8>& OutDefaultValues, EManagedClassInfoVersion Version);
+
+    // Places dirty bits after own properties, called once layout of properties is resolved.
+    // Structs without DirtyMaskOffset get no dirty bits, their setters don't know where to set them
+    void AddDirtyMask(EManagedClassInfoVersion Version);
+
+    const uint8* GetDefaultValues(EManagedClassInfoVersion Version) const {
+        return Version >= EManagedClassInfoVersion::DefaultValues ? DefaultValues : nullptr;
+    }
+
+    const FManagedReplicationParams* GetReplicationParams(EManagedClassInfoVersion Version) const {
+        return Version >= EManagedClassInfoVersion::ReplicationParams ? ReplicationParams : nullptr;
+    }
+
+    int32 GetDirtyMaskOffset(EManagedClassInfoVersion Version) const {
+        return Version >= EManagedClassInfoVersion::DirtyMask ? DirtyMaskOffset : INDEX_NONE;
+    }
+
+    // Hash of names, types, offsets and flags of own properties, valid once layout of properties is resolved.
+    // Class can be reused on reload only when it is the same, FProperties of reused class are not rebuilt
+    uint32 GetLayoutHash() const;
+
+    // Versions newer than this build would be read past fields it knows about
+    static bool IsSupportedVersion(EManagedClassInfoVersion Version) {
+        return Version >= EManagedClassInfoVersion::Initial && Version <= EManagedClassInfoVersion::Latest;
+    }
+
+    static int32 GetDirtyMaskSize(int32 NumProperties) {
+        return FMath::DivideAndRoundUp(NumProperties, 64) * (int32)sizeof(uint64);
+    }
 };
\ No newline at end of file
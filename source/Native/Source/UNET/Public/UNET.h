@@ -2,15 +2,20 @@
 
 #include <CoreMinimal.h>
 #include <Modules/ModuleManager.h>
+#include <Containers/Ticker.h>
 
 #include "LogUNET.h"
 #include "UNETSettings.h"
 #include "HostFXR.h"
 #include "UNETRuntime.h"
+#include "UNETMemory.h"
+#include "UNETBenchmark.h"
+#include "UNETTrace.h"
+#include "UNETHitchDetector.h"
 
 class FUNETModule : public IModuleInterface
 {
-    bool LoadHost();
+    bool LoadHost(const FUNETRuntimePaths& Paths);
     void LoadRuntime();
     void UnloadRuntime();
 
@@ -18,9 +23,35 @@ class FUNETModule : public IModuleInterface
     void UnloadPlugins();
     void ReloadPlugins();
 
+    void ReportMemory(FOutputDevice& Ar);
+    void ReportHitches(FOutputDevice& Ar);
+    bool UpdateMemoryStats(float DeltaTime);
+
+    // Reloads plugins changed on disk, watcher itself lives on C# side and only collects changes
+    bool ProcessPendingReloads(float DeltaTime);
+
+    // Starts or stops managed trace session following UNETManaged trace channel
+    bool UpdateTraceSession(float DeltaTime);
+    void StopTraceSession();
+
+    void Benchmark(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
+
+    void LoadClass(const TArray<FString>& Args);
+
     HostFXR Host;
     UNET::Runtime Runtime;
 
+    FTSTicker::FDelegateHandle MemoryStatsTickerHandle;
+    FTSTicker::FDelegateHandle HotReloadTickerHandle;
+    FTSTicker::FDelegateHandle TraceSessionTickerHandle;
+
+    FDelegateHandle EndFrameHandle;
+
+    bool bIsTraceSessionActive = false;
+
+    // Time of the first runtime load, that includes CLR startup
+    double ColdStartSeconds = 0.0;
+
 public:
     
     FUNETModule();
@@ -28,10 +59,25 @@ public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
 
+    static constexpr int32 DefaultBenchmarkIterations = 100000;
+
+    // Measures UNET interop paths, reloads plugins and runtime during measurement
+    bool RunBenchmarks(int32 Iterations, UNET::Benchmark& Benchmark);
+
+    // Finds managed class by name, loading plugin that declares it in manifest when plugin is loaded on demand
+    UNET_API UClass* FindOrLoadClass(FName ClassName);
+
     FAutoConsoleCommand LoadRuntimeCommand;
     FAutoConsoleCommand UnloadRuntimeCommand;
 
     FAutoConsoleCommand LoadManagedPluginsCommand;
     FAutoConsoleCommand UnloadManagedPluginsCommand;
     FAutoConsoleCommand ReloadManagedPluginsCommand;
+
+    FAutoConsoleCommandWithOutputDevice MemReportCommand;
+    FAutoConsoleCommandWithOutputDevice HitchSummaryCommand;
+
+    FAutoConsoleCommandWithWorldArgsAndOutputDevice BenchmarkCommand;
+
+    FAutoConsoleCommand LoadClassCommand;
 };
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameFramework/Actor.h>
+
+#include "UNETActor.generated.h"
+
+/**
+ *   Base of managed actors with replicated properties, registers them because managed classes have no generated code to do it.
+ */
+UCLASS(Abstract)
+class UNET_API AUNETActor : public AActor {
+    GENERATED_BODY()
+
+public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+};
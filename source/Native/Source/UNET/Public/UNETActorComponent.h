@@ -0,0 +1,17 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Components/ActorComponent.h>
+
+#include "UNETActorComponent.generated.h"
+
+/**
+ *   Base of managed actor components with replicated properties, the same as AUNETActor.
+ */
+UCLASS(Abstract)
+class UNET_API UUNETActorComponent : public UActorComponent {
+    GENERATED_BODY()
+
+public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+};
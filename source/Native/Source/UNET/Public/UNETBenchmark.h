@@ -0,0 +1,59 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+namespace UNET {
+
+    // Benchmarks that are measured by C# side, values are shared with UNET.Plugins
+    enum class EManagedBenchmark : int32 {
+        LogRoundTrip,
+        ManagedToNativeCall,
+        PropertyReadWrite,
+    };
+
+    struct FBenchmarkResult {
+        FString Name;
+        int32 Iterations;
+        double TotalSeconds;
+
+        double GetNanosecondsPerIteration() const {
+            return Iterations > 0 ? TotalSeconds * 1e9 / Iterations : 0.0;
+        }
+    };
+
+    /**
+     *   Collects timings of UNET interop paths and writes them in machine-readable form.
+     */
+    class Benchmark {
+
+        TArray<FBenchmarkResult> Results;
+
+    public:
+
+        // Count of int properties and instances of class used by PropertyReadWrite benchmark
+        static constexpr int32 NumPropertyClassProperties = 64;
+        static constexpr int32 NumPropertyClassInstances = 16;
+
+        // Managed class declared from native code, so property access is measured on real UObjects without benchmark plugin
+        static UClass* GetPropertyClass();
+
+        void Add(const TCHAR* Name, int32 Iterations, double TotalSeconds) {
+            Results.Add({ Name, Iterations, TotalSeconds });
+        }
+
+        template<typename FunctorType>
+        void Measure(const TCHAR* Name, int32 Iterations, FunctorType&& Body) {
+            auto StartTime = FPlatformTime::Seconds();
+            Body();
+            Add(Name, Iterations, FPlatformTime::Seconds() - StartTime);
+        }
+
+        const TArray<FBenchmarkResult>& GetResults() const {
+            return Results;
+        }
+
+        FString ToJson() const;
+
+        void Print(FOutputDevice& Ar) const;
+    };
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Commandlets/Commandlet.h>
+
+#include "UNETBenchmarkCommandlet.generated.h"
+
+/**
+* Measures UNET interop paths and writes results as JSON.
+* 
+* Usage: UnrealEditor-Cmd <Project> -run=UNETBenchmark -nullrhi -unattended [-iterations=N] [-output=<Path>]
+*/
+UCLASS()
+class UUNETBenchmarkCommandlet : public UCommandlet {
+
+    GENERATED_BODY()
+
+public:
+
+    UUNETBenchmarkCommandlet();
+
+    //~ UCommandlet interface
+    virtual int32 Main(const FString& Params) override;
+};
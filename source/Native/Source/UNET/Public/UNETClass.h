@@ -2,10 +2,138 @@
 
 #include <CoreMinimal.h>
 #include <UObject/UObjectAllocator.h>
+#include <UObject/CoreNet.h>
 
 #include "ManagedClassInfo.h"
 
 class UNET_API UUNETClass : public UClass {
+
+    // Constructor of the first native class in hierarchy
+    ClassConstructorType NativeConstructor;
+
+    // Offset of the first managed property, including properties of managed parents
+    int32 ManagedPropertiesOffset;
+
+    // Default values of all managed properties laid out the same way as in object, built once at registration
+    TArray<uint8> DefaultValues;
+
+    bool bHasDefaultValues;
+
+    // Live objects which nearest managed class is this one, CDOs and archetypes are not tracked
+    TSet<UObject*> Instances;
+
+    // Managed classes derived directly from this one
+    TArray<UUNETClass*> ManagedChildren;
+
+    struct FReplicatedProperty {
+        FName Name;
+        FManagedReplicationParams Params;
+    };
+
+    // Own properties with CPF_Net flag, native parent can't register them for replication by itself
+    TArray<FReplicatedProperty> ReplicatedProperties;
+
+    // FManagedClassInfo::GetLayoutHash of class when it was constructed
+    uint32 LayoutHash;
+
+    // Offset of dirty bits of own properties, INDEX_NONE when class has no own properties
+    int32 DirtyMaskOffset;
+
+    // Own properties in order of their dirty bits, names are resolved to properties when class is linked
+    TArray<FName> DirtyTrackedNames;
+    TArray<const FProperty*> DirtyTrackedProperties;
+
+    // Managed property as it is written to bulk block
+    struct FBulkProperty {
+        FName Name;
+        FName Type;
+
+        // Relative to ManagedPropertiesOffset, size includes all array elements
+        int32 Offset;
+        int32 Size;
+
+        const FProperty* Property;
+    };
+
+    // Managed properties of whole hierarchy ordered by offset
+    TArray<FBulkProperty> BulkLayout;
+    uint32 BulkLayoutHash;
+
+    // False when some of managed properties can't be copied as bytes or object references
+    bool bCanBulkSerialize;
+
+    void SetBulkLayout();
+
+    bool ShouldBulkSerialize(FArchive& Ar) const;
+
+    void SaveBulkProperties(FArchive& Ar, uint8* Data) const;
+    void LoadBulkProperties(FArchive& Ar, uint8* Data) const;
+
+    // Bulk layouts may be saved and loaded off game thread
+    static FCriticalSection BulkLayoutsLock;
+
+    // Layout tables read from packages by their hash, so blocks saved without table can be matched when class is changed
+    static TMap<uint32, TArray<FBulkProperty>> KnownBulkLayouts;
+
+    // Instance that carries layout table of each class in packages being saved, other instances refer to it.
+    // Forgotten when package save starts, so table is written again by each save
+    static TMap<TPair<const UPackage*, const UUNETClass*>, TWeakObjectPtr<UObject>> SavedBulkLayoutOwners;
+
+    static void ConstructObject(const FObjectInitializer& ObjectInitializer);
+
+    // Instances are added on async loading thread and removed by GC purge, which can also run off game thread
+    static FCriticalSection InstancesLock;
+
+    // Nearest managed class of each tracked instance by its index in GUObjectArray.
+    // Classes of objects can already be destroyed during purge, so deleted objects are never asked for their class
+    static TMap<int32, UUNETClass*> InstanceClasses;
+
+    friend class FManagedInstanceTracker;
+
+    int32 CollectInstances(UClass* Filter, UObject** OutObjects, void** OutPropertyBases, int32 Capacity, int32 Count) const;
+
 public:
-    UUNETClass(FManagedClassInfo* Info);
-};
\ No newline at end of file
+    UUNETClass(FManagedClassInfo* Info, EManagedClassInfoVersion Version, const TArray<uint8>& OwnDefaultValues);
+    virtual ~UUNETClass() override;
+
+    static bool IsManaged(const UClass* Class) {
+        // Blueprints share constructor of their parent, but have their own class type
+        return Class && Class->ClassConstructor == &ConstructObject && Class->GetClass() == UClass::StaticClass();
+    }
+
+    // Finds first managed class in hierarchy of given one
+    static UUNETClass* FindManaged(UClass* Class) {
+        while (Class && !IsManaged(Class)) {
+            Class = Class->GetSuperClass();
+        }
+
+        return static_cast<UUNETClass*>(Class);
+    }
+
+    void SetDefaultValues(UClass* BaseClass, const TArray<uint8>& OwnDefaultValues);
+
+    // Whether class was constructed from the same parent and properties, so it can be reused instead of replaced
+    bool HasSameLayout(const FManagedClassInfo* Info) const;
+
+    void SetReplicatedProperties(const FManagedClassInfo* Info, EManagedClassInfoVersion Version);
+
+    // Called when class is renamed to REINST_ and replaced by a new one, so queries of parent don't return its instances
+    void DetachFromParent();
+
+    // Adds replicated properties of all managed classes in hierarchy, called by UNET base classes with replication support
+    static void GetLifetimeReplicatedProps(const UClass* Class, TArray<FLifetimeProperty>& OutLifetimeProps);
+
+    //~ UStruct interface
+    virtual void Link(FArchive& Ar, bool bRelinkExistingProperties) override;
+    virtual void SerializeTaggedProperties(FStructuredArchive::FSlot Slot, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults, const UObject* BreakRecursionIfFullyLoad = nullptr) const override;
+
+    // Calls Callback for each property written by managed code since the last clear, including properties of managed parents
+    static void ForEachDirtyProperty(UObject* Object, TFunctionRef<void(const FProperty*)> Callback, bool bClear = true);
+
+    static bool HasDirtyProperties(const UObject* Object);
+    static void ClearDirtyProperties(UObject* Object);
+
+    // Fills buffers with live instances of Class and its subclasses, OutPropertyBases receive address of the first managed property and can be null.
+    // Returns count of all instances, only the first Capacity of them are written.
+    static int32 QueryInstances(UClass* Class, UObject** OutObjects, void** OutPropertyBases, int32 Capacity);
+};
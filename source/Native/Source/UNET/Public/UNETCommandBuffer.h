@@ -0,0 +1,99 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Templates/Casts.h>
+
+namespace UNET {
+
+    //   Note: Written by C# CommandBuffer, so layout of commands here is shared with managed code.
+    //   Each command starts with header at offset aligned to CommandAlignment, payload follows the header.
+    /**
+     *   Kind of engine operation recorded by managed code.
+     */
+    enum class EManagedCommand : uint16 {
+        Log,
+        CallFunction,
+        SetProperty,
+        MarkPropertyDirty,
+        SpawnActor,
+        DestroyActor
+    };
+
+    /**
+     *   Reference to object used by command, the same as FWeakObjectPtr it doesn't keep object alive.
+     *   Managed code records object pointer in its place, it is replaced by reference when buffer is submitted.
+     *   Object is resolved when command is executed, so commands of objects destroyed by earlier commands are skipped.
+     */
+    struct FManagedObjectRef {
+        int32 ObjectIndex;
+        int32 SerialNumber;
+
+        static FManagedObjectRef Make(UObject* Object);
+
+        // nullptr when object is destroyed or is being destroyed
+        UObject* Resolve() const;
+
+        template<typename T>
+        T* Resolve() const {
+            return Cast<T>(Resolve());
+        }
+    };
+
+    struct FManagedCommandHeader {
+        static constexpr int32 CommandAlignment = 8;
+
+        EManagedCommand Type;
+        uint16 Reserved;
+
+        // Size of command including header and padding, offset of the next command is start of this one plus Size
+        uint32 Size;
+    };
+
+    // Followed by Length UTF-16 characters without null terminator
+    struct FManagedLogCommand {
+        int32 Verbosity;
+        int32 Length;
+    };
+
+    // Parameters frame is laid out as described by FManagedFunctionInfo and starts at ParamsOffset from the start of command
+    struct FManagedCallFunctionCommand {
+        FManagedObjectRef Target;
+        FManagedObjectRef Function;
+        int32 ParamsOffset;
+        int32 ParamsSize;
+    };
+
+    // Followed by Size bytes, that are copied to Target at Offset bitwise
+    struct FManagedSetPropertyCommand {
+        FManagedObjectRef Target;
+        int32 Offset;
+        int32 Size;
+        // Push based property is marked dirty after write, INDEX_NONE for others
+        int32 RepIndex;
+        int32 Reserved;
+    };
+
+    struct FManagedMarkPropertyDirtyCommand {
+        FManagedObjectRef Target;
+        int32 RepIndex;
+        int32 Reserved;
+    };
+
+    struct FManagedSpawnActorCommand {
+        FManagedObjectRef WorldContext;
+        FManagedObjectRef Class;
+        FVector Location;
+        FRotator Rotation;
+        // Spawned actor is written to results of submit at this index, INDEX_NONE when it is not needed
+        int32 ResultIndex;
+        int32 Reserved;
+    };
+
+    struct FManagedDestroyActorCommand {
+        FManagedObjectRef Target;
+    };
+
+    static_assert(sizeof(FManagedObjectRef) == 8, "Layout of FManagedObjectRef is shared with managed code");
+    static_assert(sizeof(FManagedCommandHeader) == FManagedCommandHeader::CommandAlignment, "Payload of command must start aligned");
+    static_assert(sizeof(FManagedSpawnActorCommand) == 72, "Layout of FManagedSpawnActorCommand is shared with managed code");
+}
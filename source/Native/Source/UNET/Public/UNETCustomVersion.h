@@ -0,0 +1,25 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Misc/Guid.h>
+
+/**
+ *   Versions of data written by UNET into packages and save games.
+ */
+struct UNET_API FUNETCustomVersion {
+
+    enum Type {
+        BeforeCustomVersionWasAdded = 0,
+
+        // Managed properties can be written as a single block instead of tagged properties
+        BulkManagedProperties,
+
+        // Layout table of bulk block is written once per class in package, other blocks refer to object that has it
+        SharedBulkLayouts,
+
+        VersionPlusOne,
+        LatestVersion = VersionPlusOne - 1
+    };
+
+    static const FGuid GUID;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/Object.h>
+
+#include "UNETDelegateHandler.generated.h"
+
+namespace UNET {
+
+    /**
+     *   UnmanagedCallersOnly function of managed handler. Params point to parameters struct of delegate signature.
+     */
+    typedef void(__cdecl* FManagedDelegateCallback)(void* Handle, void* Params);
+}
+
+/**
+* Binds UE dynamic delegate to managed handler.
+* Delegate calls Invoke on this object, which is intercepted in ProcessEvent and forwarded to managed function pointer,
+* so invocation doesn't allocate or look anything up.
+*/
+UCLASS(Transient)
+class UNET_API UUNETDelegateHandler : public UObject {
+
+    GENERATED_BODY()
+
+    UNET::FManagedDelegateCallback Callback = nullptr;
+
+    // Opaque handle of managed facade, passed back to Callback as is
+    void* Handle = nullptr;
+
+    TWeakObjectPtr<UObject> Target;
+
+    FProperty* DelegateProperty = nullptr;
+
+    // Name of plugin assembly that bound handler, its handlers are unbound when it is reloaded
+    FName Owner;
+
+    // Handlers are kept alive by this list, because delegates reference them weakly
+    static TArray<UUNETDelegateHandler*> Handlers;
+
+    void Unbind();
+
+public:
+
+    static const FName InvokeFunctionName;
+
+    // Signature doesn't matter, handler is called with parameters of delegate it is bound to
+    UFUNCTION()
+    void Invoke() {}
+
+    //~ UObject interface
+    virtual void ProcessEvent(UFunction* Function, void* Params) override;
+
+    // Binds single-cast or multicast dynamic delegate property of Target, returns nullptr when there is no such delegate
+    static UUNETDelegateHandler* Bind(UObject* Target, FName DelegateName, UNET::FManagedDelegateCallback Callback, void* Handle, FName Owner);
+
+    static void Unbind(UUNETDelegateHandler* Handler);
+
+    // Managed function pointers become invalid when plugins are unloaded, so all handlers are unbound at that moment
+    static void UnbindAll();
+
+    // Unbinds handlers of a single plugin, so bindings of plugins that are not reloaded stay
+    static void UnbindOwnedBy(FName Owner);
+
+    static int32 Num() {
+        return Handlers.Num();
+    }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+namespace UNET {
+
+    //   Note: Filled once per call stub when facade is linked, so calls don't look anything up by name.
+    /**
+     *   Layout of parameters of UFunction called from managed code.
+     */
+    struct FManagedFunctionInfo {
+        UFunction* Function;
+
+        // Size and alignment of parameters frame, that is built on managed side
+        int32 ParamsSize;
+        int32 ParamsAlignment;
+
+        // Offset of return value in parameters frame, or INDEX_NONE when function returns nothing
+        int32 ReturnValueOffset;
+
+        // Count of parameters without return value
+        int32 NumParams;
+    };
+}
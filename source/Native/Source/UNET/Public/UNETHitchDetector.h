@@ -0,0 +1,42 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+namespace UNET {
+
+    //   Note: Filled on C# side, counters are cumulative since runtime start, so two snapshots describe activity between them.
+    /**
+     *   State of .NET runtime, that tells whether hitch was caused by GC or JIT.
+     */
+    struct FManagedRuntimeState {
+        int64 GCCounts[3];
+        int64 AllocatedBytes;
+        int64 JitCompiledMethods;
+        // In TimeSpan ticks of 100 ns
+        int64 JitTimeTicks;
+    };
+
+    /**
+     *   Marks native to managed call made on game thread, so hitch detector knows where frame time went.
+     */
+    class FManagedCallScope {
+
+        bool bIsTracked;
+
+    public:
+
+        explicit FManagedCallScope(FName Name);
+        ~FManagedCallScope();
+    };
+
+    /**
+     *   Starts watchdog, that logs frames which spent more than ThresholdMs in managed code and calls that are stuck for longer than that.
+     */
+    void StartHitchDetector(float ThresholdMs);
+    void StopHitchDetector();
+
+    /**
+     *   Prints hitches kept in rolling history.
+     */
+    void ReportHitchSummary(FOutputDevice& Ar);
+}
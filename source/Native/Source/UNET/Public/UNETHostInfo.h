@@ -0,0 +1,25 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+namespace UNET {
+
+    // Kind of running process, values are shared with PluginTargets on C# side
+    enum class EManagedHostTarget : int32 {
+        Editor = 1 << 0,
+        Game = 1 << 1,
+        Client = 1 << 2,
+        Server = 1 << 3,
+    };
+
+    /**
+     *   Describes process that hosts managed plugins, so loader can skip plugins that are not used by it.
+     */
+    struct FManagedHostInfo {
+        EManagedHostTarget Target;
+
+        // Platform name used by ini files, like Windows or Linux
+        const TCHAR* Platform;
+        int32 PlatformLength;
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <HAL/LowLevelMemTracker.h>
+
+LLM_DECLARE_TAG_API(UNET_Managed, UNET_API);
+LLM_DECLARE_TAG_API(UNET_Interop, UNET_API);
+
+namespace UNET {
+
+    //   Note: Filled on C# side from GC.GetGCMemoryInfo, so values describe the heap as of the last GC.
+    /**
+     *   Snapshot of managed heap hosted by UNET runtime.
+     */
+    struct FManagedMemoryInfo {
+        int64 GCIndex;
+        int64 HeapSizeBytes;
+        int64 CommittedBytes;
+        int64 FragmentedBytes;
+        int64 GenerationSizeBytes[3];
+        int64 LargeObjectHeapSizeBytes;
+        int64 PinnedObjectHeapSizeBytes;
+        int64 PinnedObjectsCount;
+    };
+
+    /**
+     *   Called from C# once per loaded plugin while managed memory info is collected, with size of assembly images loaded by plugin.
+     */
+    typedef void(__cdecl* FManagedPluginMemoryCallback)(void* Context, const TCHAR* PluginName, int32 NameLength, int64 ImageBytes, int32 NumAssemblies);
+
+    /**
+     *   Queries managed heap usage and size of assembly images loaded by each plugin and prints them to output device.
+     */
+    void ReportManagedMemory(FOutputDevice& Ar);
+
+    /**
+     *   Pushes current managed heap size into LLM, so memory budgets include .NET side.
+     */
+    void UpdateManagedMemoryStats();
+
+    /**
+     *   Allocates memory of frame arena used by managed code for per-frame scratch buffers.
+     */
+    void InitializeFrameArena(int64 CapacityBytes);
+
+    /**
+     *   Makes all memory allocated from frame arena available again, called at the end of each frame.
+     */
+    void ResetFrameArena();
+
+    void ReleaseFrameArena();
+}
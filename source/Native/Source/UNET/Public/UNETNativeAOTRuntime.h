@@ -0,0 +1,39 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "UNETSettings.h"
+#include "Delegates.h"
+
+namespace UNET {
+
+    // Entry point of UNET Plugin Loader, exported by both CLR-hosted assembly and NativeAOT library
+    typedef void(__cdecl* RuntimeInitializer)(
+        const TCHAR* managedPluginsPath,
+        int pathLength,
+        const struct NativeDelegates* nativeDelegates,
+        const struct PluginLoaderDelegates* pluginLoaderDelegates
+    );
+
+    //   Note: NativeAOT runtime can't be unloaded from the process too, so library is never freed after initialization.
+    /**
+     *   Runs UNET Plugin Loader and plugins compiled with NativeAOT into a single shared library.
+     *   It doesn't need hostfxr and doesn't JIT anything, so startup is cheaper, but plugins can't be hot reloaded.
+     */
+    class NativeAOTRuntime {
+
+        void* Handle = nullptr;
+
+    public:
+
+        static constexpr const TCHAR* EntryPoint = TEXT("UNET_Init");
+
+        NativeAOTRuntime() {}
+
+        bool IsLoaded() const {
+            return !!Handle;
+        }
+
+        bool Load(const FUNETRuntimePaths& Paths);
+    };
+}
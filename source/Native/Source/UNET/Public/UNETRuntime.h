@@ -5,29 +5,44 @@
 #include "UNETSettings.h"
 #include "Delegates.h"
 #include "HostFXR.h"
+#include "UNETNativeAOTRuntime.h"
 
 namespace UNET {
 
+    //   Note: CLR can't be unloaded from the process, so once initialized it stays alive until module shutdown.
+    //   Unload and Load after that are only a logical reset of UNET, that doesn't pay CLR startup cost again.
     class Runtime {
 
-        typedef void(__cdecl* Initializer)(
-            const TCHAR* managedPluginsPath,
-            int pathLength,
-            const struct NativeDelegates* nativeDelegates,
-            const struct PluginLoaderDelegates* pluginLoaderDelegates
-        );
+        typedef RuntimeInitializer Initializer;
 
         hostfxr_handle Handle = nullptr;
 
+        // Used instead of hostfxr when NativeAOT backend is selected
+        NativeAOTRuntime NativeAOT;
+
+        bool bIsActive = false;
+
     public:
 
         Runtime() {}
 
         bool IsActive() {
-            return !!Handle;
+            return bIsActive;
+        }
+
+        // Whether CLR or NativeAOT runtime is already started in current process
+        bool IsInitialized() {
+            return Handle || NativeAOT.IsLoaded();
         }
 
-        void Load(const HostFXR& Host, const UUNETSettings* Settings);
-        void Unload(const HostFXR& Host);
+        bool IsNativeAOT() const {
+            return NativeAOT.IsLoaded();
+        }
+
+        // Paths and backend are used only for the first load, when runtime is started
+        void Load(const HostFXR& Host, const UUNETSettings* Settings, const FUNETRuntimePaths& Paths);
+        void Unload();
+
+        void Shutdown(const HostFXR& Host);
     };
-}
\ No newline at end of file
+}
@@ -23,6 +23,43 @@
 #define HOSTFXR_LIB "libhostfxr.dylib"
 #endif
 
+/**
+* Paths required to load UNET runtime, resolved and checked once per runtime load
+*/
+struct FUNETRuntimePaths {
+    FString HostfxrLibPath;
+    FString ManagedPluginsPath;
+    FString LoaderLibraryPath;
+    FString LoaderConfigPath;
+    FString NativeAOTLibraryPath;
+};
+
+/**
+* Runtime used to run managed plugins
+*/
+UENUM()
+enum class EUNETRuntimeBackend : uint8 {
+    // CLR hosted via hostfxr, plugins are JIT-compiled and can be reloaded
+    HostFXR UMETA(DisplayName = "HostFXR"),
+
+    // Loader and plugins are compiled with NativeAOT into a single shared library
+    NativeAOT UMETA(DisplayName = "NativeAOT")
+};
+
+/**
+* Events of .NET runtime forwarded to Unreal Insights, values are shared with UNET.Plugins
+*/
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EUNETManagedTraceEvents : uint8 {
+    None = 0 UMETA(Hidden),
+    GC = 1 << 0 UMETA(DisplayName = "GC pauses"),
+    Jit = 1 << 1 UMETA(DisplayName = "JIT compilation"),
+    Exceptions = 1 << 2,
+    ThreadPool = 1 << 3 UMETA(DisplayName = "Thread pool")
+};
+
+ENUM_CLASS_FLAGS(EUNETManagedTraceEvents);
+
 using namespace UC;
 using namespace UP;
 using namespace UM;
@@ -47,7 +84,7 @@ private:
 #endif
     }
 
-    FString GetEmbeddedDotnetInstallDir() {
+    static FString GetEmbeddedDotnetInstallDir() {
         return FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectDir(), "Binaries/Runtime"));
     }
 
@@ -67,36 +104,15 @@ private:
     }
 #endif
 
-    void UpdateDotnetInstallations() {
+    static constexpr uint16 MinimalDotNetVersion = MINIMAL_DOTNET_VERSION;
 
-        AvailableDotNetInstallations.Empty();
+    // Walks host/fxr directory, sorted from oldest to newest
+    static TArray<FString> FindDotnetInstallations(const FString& HostDir, bool bAllowPreview);
 
-        auto HostDir = GetHostfxrPath();
-
-        auto AddDirectory = [&](const TCHAR* Path, bool bIsDir) -> bool {
-            if (!bIsDir) {
-                return true;
-            }
-
-            auto PathStr = FString(Path);
-
-            auto DirName = PathStr.Right(PathStr.Len() - HostDir.Len() - 1);
-
-            FVersion FoundVersion;
-
-            if (!FVersion::TryParse(DirName, FoundVersion) ||
-                (FoundVersion.Major < MINIMAL_DOTNET_VERSION) ||
-                (FoundVersion.bIsPreview && !bAllowDotNetPreview)) {
-                return true;
-            }
-
-            AvailableDotNetInstallations.Add(DirName);
-
-            return true;
-        };
-
-        FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*HostDir, AddDirectory);
-    }
+#if WITH_EDITOR
+    // Reuses result of previous editor session while host/fxr directory is not modified
+    void UpdateDotnetInstallations();
+#endif
 
     TArray<FString> AvailableDotNetInstallations;
 
@@ -118,6 +134,12 @@ public:
     }
 
     UUNETSettings(const FObjectInitializer& ObjectInitializer);
+
+    /**
+    * Runtime used to run managed plugins. NativeAOT starts without JIT, but doesn't support plugins reload
+    */
+    UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = ".NET", meta = (DisplayName = "Runtime backend", ConfigRestartRequired = true))
+    EUNETRuntimeBackend RuntimeBackend;
     
     /**
     * Path to .NET installations    
@@ -137,6 +159,45 @@ public:
     UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = ".NET", AdvancedDisplay, meta = (DisplayName = "Allow preview"))
     bool bAllowDotNetPreview;
 
+    /**
+    * Runtime events written to Unreal Insights while UNETManaged trace channel is enabled
+    */
+    UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Diagnostics", meta = (DisplayName = "Traced managed events", Bitmask, BitmaskEnum = "/Script/UNET.EUNETManagedTraceEvents"))
+    int32 ManagedTraceEvents;
+
+    /**
+    * Frames that spend longer than this in managed code on game thread are logged together with GC and JIT activity, 0 disables detection.
+    * Calls that exceed it on their own are reported while they are still running
+    */
+    UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Diagnostics", meta = (DisplayName = "Managed hitch threshold (ms)", ClampMin = 0, ConfigRestartRequired = true))
+    float ManagedHitchThresholdMs;
+
+    /**
+    * Size of memory reused every frame by managed scratch buffers, allocations over it fall back to FMalloc
+    */
+    UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Memory", meta = (DisplayName = "Frame arena size (KB)", ClampMin = 0, ConfigRestartRequired = true))
+    int32 FrameArenaSizeKB;
+
+    /**
+    * Minimal count of worker threads of .NET thread pool, 0 keeps the value chosen by runtime
+    */
+    UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Threading", meta = (DisplayName = "Thread pool min threads", ClampMin = 0))
+    int32 ManagedThreadPoolMinThreads;
+
+    /**
+    * Maximal count of worker threads of .NET thread pool, 0 keeps the value chosen by runtime.
+    * Managed code can use engine workers via EngineParallel and EngineTaskScheduler instead
+    */
+    UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Threading", meta = (DisplayName = "Thread pool max threads", ClampMin = 0))
+    int32 ManagedThreadPoolMaxThreads;
+
+    /**
+    * Managed properties of saved objects are written as a single binary block instead of tagged properties.
+    * Packages saved this way can be loaded with the option disabled, layout changes are resolved by property names
+    */
+    UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Serialization", meta = (DisplayName = "Bulk serialize managed properties"))
+    bool bBulkSerializeManagedProperties;
+
     UFUNCTION()
     TArray<FString> GetDotnetInstallations() const {
         return AvailableDotNetInstallations;
@@ -151,7 +212,20 @@ public:
     }
 
     FString GetHostfxrLibPath() const {
-        return FPaths::Combine(GetHostfxrPath(), DotNetVersion, HOSTFXR_LIB);
+        return GetHostfxrLibPath(DotNetVersion);
+    }
+
+    FString GetHostfxrLibPath(const FString& Version) const {
+        return GetHostfxrLibPath(GetHostfxrPath(), Version);
+    }
+
+    static FString GetHostfxrLibPath(const FString& HostDir, const FString& Version) {
+        return FPaths::Combine(HostDir, Version, HOSTFXR_LIB);
+    }
+
+    // Runtime packaged by UNET.Runtime project together with the game
+    static FString GetEmbeddedHostfxrPath() {
+        return FPaths::Combine(GetEmbeddedDotnetInstallDir(), TEXT("host/fxr"));
     }
 
     FString GetManagedPluginsPath() const {
@@ -165,12 +239,22 @@ public:
     FString GetUNETLoaderConfigPath() const {
         return FPaths::Combine(GetManagedPluginsPath(), "UNET.Plugins.runtimeconfig.json");
     }
+
+    // Generated by UNET.Runtime project, references trimmed runtime packaged with the game
+    FString GetPackagedLoaderConfigPath() const {
+        return FPaths::Combine(GetManagedPluginsPath(), "UNET.Runtime.runtimeconfig.json");
+    }
+
+    FString GetNativeAOTLibraryPath() const {
+        return FPaths::Combine(GetManagedPluginsPath(), "NativeAOT", FString("UNET.NativeAOT.") + FPlatformProcess::GetModuleExtension());
+    }
     
     const FString EntryType = FString("UNET.Plugins.Loader, UNET.Plugins");
 
     const FString EntryMethod = FString("Init");
 
-    bool Validate() const;
+    // Single preflight pass before runtime load, OutPaths are valid only when it succeeds
+    bool Validate(FUNETRuntimePaths& OutPaths) const;
 };
 
 #undef MINIMAL_DOTNET_VERSION
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+namespace UNET {
+
+    /**
+     *   UnmanagedCallersOnly function that processes elements from Start up to End of managed ParallelFor.
+     */
+    typedef void(__cdecl* FManagedParallelForCallback)(void* Context, int32 Start, int32 End);
+
+    /**
+     *   UnmanagedCallersOnly function that runs managed task on engine worker thread.
+     */
+    typedef void(__cdecl* FManagedTaskCallback)(void* Context);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Trace/Trace.h>
+
+UE_TRACE_CHANNEL_EXTERN(UNETManagedChannel, UNET_API);
+
+namespace UNET {
+
+    // Runtime events forwarded from C# side, values are shared with UNET.Plugins
+    enum class EManagedTraceEvent : int32 {
+        GCPause,
+        JitCompilation,
+        Exception,
+        ThreadPoolWorkers,
+    };
+
+    //   Note: Filled on C# side from EventWrittenEventArgs, events are delivered by EventPipe in batches,
+    //   so each one carries its own age instead of being timestamped when it reaches native side.
+    /**
+     *   Single event of .NET runtime.
+     */
+    struct FManagedTraceEvent {
+        EManagedTraceEvent Type;
+
+        // GC generation, count of thread pool workers
+        int32 Value;
+
+        // Time passed since the end of event, and its duration if it has one
+        double SecondsAgo;
+        double DurationSeconds;
+
+        // Type of exception, name of compiled method
+        const TCHAR* Name;
+        int32 NameLength;
+    };
+
+    /**
+     *   Whether managed events are requested by connected trace session.
+     */
+    bool IsManagedTraceEnabled();
+}
@@ -4,76 +4,174 @@
 
 struct FVersion {
 
-    FVersion(int8 Major = 0, int8 Minor = 0, int8 Patch = 0, int8 Hotfix = 0, bool bIsPreview = false) :
+    // Pre-release labels used by .NET, ordered the same way as they are released
+    enum class EStage : uint8 {
+        Alpha,
+        Beta,
+        Preview,
+        RC,
+        Release
+    };
+
+    FVersion(uint16 Major = 0, uint16 Minor = 0, uint16 Patch = 0, uint16 Hotfix = 0, EStage Stage = EStage::Release, uint16 StageNumber = 0) :
         Major(Major),
         Minor(Minor),
         Patch(Patch),
         Hotfix(Hotfix),
-        bIsPreview(bIsPreview) {}
-
-    union {
-        struct {
-            uint8 Major;
-            uint8 Minor;
-            uint8 Patch;
-            uint8 Hotfix;
-        };
+        Stage(Stage),
+        StageNumber(StageNumber),
+        bIsPreview(Stage != EStage::Release) {}
 
-        uint32 Inlined;
-    };
+    uint16 Major;
+    uint16 Minor;
+    uint16 Patch;
+    uint16 Hotfix;
+
+    EStage Stage;
+    uint16 StageNumber;
 
     bool bIsPreview;
 
-    static bool TryParse(FString Input, FVersion& Result) {
-        FString MajorStr, MinorStr, PatchStr, HotfixStr, Preview;
+    /**
+    * Parses versions like "6.0.11", "6.0.11.1" or "8.0.0-rc.2.23479.6" without allocations.
+    * Build numbers after pre-release number are ignored.
+    */
+    static bool TryParse(FStringView Input, FVersion& Result) {
+        auto It = Input.GetData();
+        auto End = It + Input.Len();
+
+        auto Consume = [&](TCHAR Char) {
+            if (It != End && *It == Char) {
+                ++It;
+                return true;
+            }
+
+            return false;
+        };
+
+        auto ParseNumber = [&](uint16& Number) {
+            if (It == End || !FChar::IsDigit(*It)) {
+                return false;
+            }
+
+            uint32 Value = 0;
+
+            for (; It != End && FChar::IsDigit(*It); ++It) {
+                Value = Value * 10 + (*It - TEXT('0'));
+
+                if (Value > MAX_uint16) {
+                    return false;
+                }
+            }
+
+            Number = (uint16)Value;
+            return true;
+        };
+
+        auto ParseStage = [&](EStage& ParsedStage) {
+            auto LabelStart = It;
+
+            while (It != End && FChar::IsAlpha(*It)) {
+                ++It;
+            }
+
+            auto Label = FStringView(LabelStart, UE_PTRDIFF_TO_INT32(It - LabelStart));
+
+            if (Label.Equals(TEXT("alpha"), ESearchCase::IgnoreCase)) {
+                ParsedStage = EStage::Alpha;
+            }
+            else if (Label.Equals(TEXT("beta"), ESearchCase::IgnoreCase)) {
+                ParsedStage = EStage::Beta;
+            }
+            else if (Label.Equals(TEXT("preview"), ESearchCase::IgnoreCase)) {
+                ParsedStage = EStage::Preview;
+            }
+            else if (Label.Equals(TEXT("rc"), ESearchCase::IgnoreCase)) {
+                ParsedStage = EStage::RC;
+            }
+            else {
+                return false;
+            }
+
+            return true;
+        };
+
+        FVersion Version;
+
+        if (!ParseNumber(Version.Major) || !Consume(TEXT('.')) ||
+            !ParseNumber(Version.Minor) || !Consume(TEXT('.')) ||
+            !ParseNumber(Version.Patch)) {
+            return false;
+        }
 
-        auto Success = Input.Split(TEXT("."), &MajorStr, &MinorStr) && MinorStr.Split(TEXT("."), &MinorStr, &PatchStr);
-        auto bIsPreview = PatchStr.Split(TEXT("-preview."), &PatchStr, &Preview);
+        if (Consume(TEXT('.')) && !ParseNumber(Version.Hotfix)) {
+            return false;
+        }
 
-        auto bHasHotfix = PatchStr.Split(TEXT("."), &PatchStr, &HotfixStr);
+        if (Consume(TEXT('-'))) {
+            if (!ParseStage(Version.Stage) || (Consume(TEXT('.')) && !ParseNumber(Version.StageNumber))) {
+                return false;
+            }
 
-        if (!Success)
-        {
+            Version.bIsPreview = true;
+        }
+        else if (It != End) {
             return false;
         }
 
-        Result = FVersion(
-            atoi(TCHAR_TO_ANSI(*MajorStr)),
-            atoi(TCHAR_TO_ANSI(*MinorStr)),
-            atoi(TCHAR_TO_ANSI(*PatchStr)),
-            bHasHotfix ? atoi(TCHAR_TO_ANSI(*HotfixStr)) : 0,
-            bIsPreview);
+        Result = Version;
+        return true;
+    }
+
+    // Pre-release is older than release of the same version, hotfix is newer
+    int32 Compare(const FVersion& Other) const {
+        const uint16 Lhs[] = { Major, Minor, Patch, (uint16)Stage, StageNumber, Hotfix };
+        const uint16 Rhs[] = { Other.Major, Other.Minor, Other.Patch, (uint16)Other.Stage, Other.StageNumber, Other.Hotfix };
+
+        for (int32 i = 0; i < UE_ARRAY_COUNT(Lhs); i++) {
+            if (Lhs[i] != Rhs[i]) {
+                return Lhs[i] < Rhs[i] ? -1 : 1;
+            }
+        }
 
-        return Success;
+        return 0;
     }
 
     friend bool operator <(const FVersion& lhs, const FVersion& rhs) {
-        return lhs.Inlined < rhs.Inlined;
+        return lhs.Compare(rhs) < 0;
     }
 
     friend bool operator >(const FVersion& lhs, const FVersion& rhs) {
-        return lhs.Inlined > rhs.Inlined;
+        return lhs.Compare(rhs) > 0;
     }
 
     friend bool operator <=(const FVersion& lhs, const FVersion& rhs) {
-        return lhs.Inlined < rhs.Inlined || lhs == rhs;
+        return lhs.Compare(rhs) <= 0;
     }
 
     friend bool operator >=(const FVersion& lhs, const FVersion& rhs) {
-        return lhs.Inlined > rhs.Inlined || lhs == rhs;
+        return lhs.Compare(rhs) >= 0;
     }
 
     friend bool operator ==(const FVersion& lhs, const FVersion& rhs) {
-        return lhs.Inlined == rhs.Inlined && !(lhs.bIsPreview ^ rhs.bIsPreview);
+        return lhs.Compare(rhs) == 0;
     }
 
     friend bool operator !=(const FVersion& lhs, const FVersion& rhs) {
-        return lhs.Inlined == rhs.Inlined && !(lhs.bIsPreview ^ rhs.bIsPreview);
+        return lhs.Compare(rhs) != 0;
     }
 
-    FString ToString() {
-        return Hotfix ?
+    FString ToString() const {
+        static const TCHAR* StageLabels[] = { TEXT("alpha"), TEXT("beta"), TEXT("preview"), TEXT("rc") };
+
+        auto Result = Hotfix ?
             FString::Format(TEXT("{0}.{1}.{2}.{3}"), { Major, Minor, Patch, Hotfix }) :
             FString::Format(TEXT("{0}.{1}.{2}"), { Major, Minor, Patch });
+
+        if (bIsPreview) {
+            Result += FString::Format(TEXT("-{0}.{1}"), { StageLabels[(uint8)Stage], StageNumber });
+        }
+
+        return Result;
     }
 };
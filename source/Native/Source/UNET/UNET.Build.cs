@@ -36,12 +36,28 @@ public class UNET : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
-				"DeveloperSettings"
+				"DeveloperSettings",
+				"Json",
+				"NetCore"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
 		
 		
+		// .NET runtime and managed plugins are loaded from disk, so they are staged as loose files
+		if (Target.ProjectFile != null)
+		{
+			foreach (var Directory in new[] { "Runtime", "Managed" })
+			{
+				var Path = System.IO.Path.Combine(Target.ProjectFile.Directory.FullName, "Binaries", Directory);
+
+				if (System.IO.Directory.Exists(Path))
+				{
+					RuntimeDependencies.Add(System.IO.Path.Combine(Path, "..."), StagedFileType.NonUFS);
+				}
+			}
+		}
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
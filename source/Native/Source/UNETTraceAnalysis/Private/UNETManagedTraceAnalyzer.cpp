@@ -0,0 +1,90 @@
+#include "UNETManagedTraceAnalyzer.h"
+
+#include <TraceServices/Model/Threads.h>
+
+namespace {
+
+    // Ids of tracks that don't match any real thread, trace thread ids are assigned from small numbers
+    constexpr uint32 GCThreadId = 0xFFFF0001;
+    constexpr uint32 JitThreadId = 0xFFFF0002;
+}
+
+UNET::FManagedTraceAnalyzer::FManagedTraceAnalyzer(TraceServices::IAnalysisSession& InSession) :
+    Session(InSession),
+    TimingProvider(TraceServices::EditTimingProfilerProvider(InSession)),
+    GCTrack{ GCThreadId },
+    JitTrack{ JitThreadId } {}
+
+void UNET::FManagedTraceAnalyzer::OnAnalysisBegin(const FOnAnalysisContext& Context) {
+    auto& Builder = Context.InterfaceBuilder;
+    Builder.RouteEvent(RouteId_GCPause, "UNETManaged", "GCPause");
+    Builder.RouteEvent(RouteId_JitCompilation, "UNETManaged", "JitCompilation");
+
+    TraceServices::FAnalysisSessionEditScope _(Session);
+
+    auto& ThreadProvider = TraceServices::EditThreadProvider(Session);
+    ThreadProvider.AddThread(GCThreadId, TEXT("Managed GC"), TPri_Normal);
+    ThreadProvider.AddThread(JitThreadId, TEXT("Managed JIT"), TPri_Normal);
+    ThreadProvider.SetThreadGroup(GCThreadId, TEXT("UNET"));
+    ThreadProvider.SetThreadGroup(JitThreadId, TEXT("UNET"));
+}
+
+bool UNET::FManagedTraceAnalyzer::OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context) {
+    if (!TimingProvider) {
+        return false;
+    }
+
+    auto& EventData = Context.EventData;
+    auto StartTime = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("StartCycle"));
+    auto EndTime = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("EndCycle"));
+
+    TraceServices::FAnalysisSessionEditScope _(Session);
+
+    switch (RouteId) {
+    case RouteId_GCPause: {
+        auto Generation = EventData.GetValue<int32>("Generation");
+        auto Timer = GCTimers.Find(Generation);
+
+        if (!Timer) {
+            Timer = &GCTimers.Add(Generation, TimingProvider->AddCpuTimer(*FString::Printf(TEXT("Managed GC (gen %d)"), Generation), nullptr, 0));
+        }
+
+        AppendEvent(GCTrack, *Timer, StartTime, EndTime);
+        break;
+    }
+    case RouteId_JitCompilation: {
+        FString Method;
+        EventData.GetString("Method", Method);
+
+        auto Timer = JitTimers.Find(Method);
+
+        if (!Timer) {
+            Timer = &JitTimers.Add(Method, TimingProvider->AddCpuTimer(*FString::Printf(TEXT("JIT %s"), *Method), nullptr, 0));
+        }
+
+        AppendEvent(JitTrack, *Timer, StartTime, EndTime);
+        break;
+    }
+    default:
+        break;
+    }
+
+    return true;
+}
+
+void UNET::FManagedTraceAnalyzer::AppendEvent(FTrack& Track, uint32 TimerIndex, double StartTime, double EndTime) {
+    // Timeline is a stack of scopes, events of one track must not overlap and must come in order.
+    // Runtime reports them in order, rounding of their age to cycles can only make them touch
+    StartTime = FMath::Max(StartTime, Track.LastEndTime);
+    EndTime = FMath::Max(EndTime, StartTime);
+
+    TraceServices::FTimingProfilerEvent Event;
+    Event.TimerIndex = TimerIndex;
+
+    auto& Timeline = TimingProvider->GetCpuThreadEditableTimeline(Track.ThreadId);
+    Timeline.AppendBeginEvent(StartTime, Event);
+    Timeline.AppendEndEvent(EndTime);
+
+    Track.LastEndTime = EndTime;
+    Session.UpdateDurationSeconds(EndTime);
+}
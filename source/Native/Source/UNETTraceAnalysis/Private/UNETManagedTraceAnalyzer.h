@@ -0,0 +1,46 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Trace/Analyzer.h>
+#include <TraceServices/Model/AnalysisSession.h>
+#include <TraceServices/Model/TimingProfiler.h>
+
+namespace UNET {
+
+    //   Note: UNETManaged events are written by UNET module when EventPipe delivers them, so their cycles are in the past.
+    //   Stock CPU timing events can only be written at current time, that's why this analyzer places them on the timeline.
+    /**
+     *   Turns UNETManaged.GCPause and UNETManaged.JitCompilation trace events into timing events of Unreal Insights.
+     *   Each kind gets its own track, because runtime events don't belong to any thread of the process.
+     */
+    class FManagedTraceAnalyzer : public UE::Trace::IAnalyzer {
+
+        enum : uint16 {
+            RouteId_GCPause,
+            RouteId_JitCompilation,
+        };
+
+        struct FTrack {
+            uint32 ThreadId;
+            double LastEndTime = 0.0;
+        };
+
+        TraceServices::IAnalysisSession& Session;
+        TraceServices::IEditableTimingProfilerProvider* TimingProvider;
+
+        FTrack GCTrack;
+        FTrack JitTrack;
+
+        TMap<int32, uint32> GCTimers;
+        TMap<FString, uint32> JitTimers;
+
+        void AppendEvent(FTrack& Track, uint32 TimerIndex, double StartTime, double EndTime);
+
+    public:
+
+        explicit FManagedTraceAnalyzer(TraceServices::IAnalysisSession& InSession);
+
+        virtual void OnAnalysisBegin(const FOnAnalysisContext& Context) override;
+        virtual bool OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context) override;
+    };
+}
@@ -0,0 +1,50 @@
+#include <CoreMinimal.h>
+#include <Features/IModularFeatures.h>
+#include <Modules/ModuleManager.h>
+#include <TraceServices/ModuleService.h>
+
+#include "UNETManagedTraceAnalyzer.h"
+
+namespace {
+
+    /**
+     *   Adds analyzer of UNETManaged events to every analysis session of Unreal Insights.
+     */
+    class FManagedTraceModule : public TraceServices::IModule {
+
+    public:
+
+        virtual void GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo) override {
+            OutModuleInfo.Name = TEXT("UNETManaged");
+            OutModuleInfo.DisplayName = TEXT("UNET Managed Runtime");
+        }
+
+        virtual void OnAnalysisBegin(TraceServices::IAnalysisSession& Session) override {
+            // Session owns analyzer
+            Session.AddAnalyzer(new UNET::FManagedTraceAnalyzer(Session));
+        }
+
+        virtual void GetLoggers(TArray<const TCHAR*>& OutLoggers) override {
+            OutLoggers.Add(TEXT("UNETManaged"));
+        }
+
+        virtual void GenerateReports(const TraceServices::IAnalysisSession& Session, const TCHAR* CmdLine, const TCHAR* OutputDirectory) override {}
+    };
+}
+
+class FUNETTraceAnalysisModule : public IModuleInterface {
+
+    FManagedTraceModule TraceModule;
+
+public:
+
+    virtual void StartupModule() override {
+        IModularFeatures::Get().RegisterModularFeature(TraceServices::ModuleFeatureName, &TraceModule);
+    }
+
+    virtual void ShutdownModule() override {
+        IModularFeatures::Get().UnregisterModularFeature(TraceServices::ModuleFeatureName, &TraceModule);
+    }
+};
+
+IMPLEMENT_MODULE(FUNETTraceAnalysisModule, UNETTraceAnalysis)
@@ -0,0 +1,18 @@
+using UnrealBuildTool;
+
+public class UNETTraceAnalysis : ModuleRules
+{
+	public UNETTraceAnalysis(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"TraceAnalysis",
+				"TraceServices"
+			}
+			);
+	}
+}